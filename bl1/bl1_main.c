@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,6 +16,7 @@
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
 #include <drivers/console.h>
+#include <lib/boot_prof.h>
 #include <lib/cpus/errata_report.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
@@ -56,11 +57,17 @@ void bl1_calc_bl2_mem_layout(const meminfo_t *bl1_mem_layout,
  ******************************************************************************/
 void bl1_setup(void)
 {
+	BOOT_PROF_BEGIN(BOOT_PROF_STAGE, 0U);
+
 	/* Perform early platform-specific setup */
+	BOOT_PROF_BEGIN(BOOT_PROF_EARLY_PLAT_SETUP, 0U);
 	bl1_early_platform_setup();
+	BOOT_PROF_END(BOOT_PROF_EARLY_PLAT_SETUP, 0U);
 
 	/* Perform late platform-specific setup */
+	BOOT_PROF_BEGIN(BOOT_PROF_PLAT_ARCH_SETUP, 0U);
 	bl1_plat_arch_setup();
+	BOOT_PROF_END(BOOT_PROF_PLAT_ARCH_SETUP, 0U);
 
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
@@ -127,7 +134,9 @@ void bl1_main(void)
 #endif /* TRUSTED_BOARD_BOOT */
 
 	/* Perform platform setup in BL1. */
+	BOOT_PROF_BEGIN(BOOT_PROF_PLAT_SETUP, 0U);
 	bl1_platform_setup();
+	BOOT_PROF_END(BOOT_PROF_PLAT_SETUP, 0U);
 
 #if ENABLE_PAUTH
 	/* Store APIAKey_EL1 key */
@@ -142,10 +151,16 @@ void bl1_main(void)
 	 * We currently interpret any image id other than
 	 * BL2_IMAGE_ID as the start of firmware update.
 	 */
-	if (image_id == BL2_IMAGE_ID)
+	if (image_id == BL2_IMAGE_ID) {
 		bl1_load_bl2();
-	else
+
+		/* Pass the boot profile records on to BL2 */
+		BOOT_PROF_END(BOOT_PROF_STAGE, 0U);
+		boot_prof_handoff(
+			&bl1_plat_get_image_desc(BL2_IMAGE_ID)->ep_info);
+	} else {
 		NOTICE("BL1-FWU: *******FWU Process Started*******\n");
+	}
 
 	bl1_prepare_next_image(image_id);
 
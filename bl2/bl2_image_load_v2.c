@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,6 +15,7 @@
 #include <common/debug.h>
 #include <common/desc_image_load.h>
 #include <drivers/auth/auth_mod.h>
+#include <lib/boot_prof.h>
 #include <plat/common/platform.h>
 
 #include "bl2_private.h"
@@ -53,7 +54,9 @@ struct entry_point_info *bl2_load_images(void)
 				WARN("BL2: Platform setup already done!!\n");
 			} else {
 				INFO("BL2: Doing platform setup\n");
+				BOOT_PROF_BEGIN(BOOT_PROF_PLAT_SETUP, 0U);
 				bl2_platform_setup();
+				BOOT_PROF_END(BOOT_PROF_PLAT_SETUP, 0U);
 				plat_setup_done = 1;
 			}
 		}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -17,6 +17,7 @@
 #if MEASURED_BOOT
 #include <drivers/measured_boot/measured_boot.h>
 #endif
+#include <lib/boot_prof.h>
 #include <lib/extensions/pauth.h>
 #include <plat/common/platform.h>
 
@@ -35,11 +36,19 @@
 void bl2_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 	       u_register_t arg3)
 {
+	/* Start from the boot profile records of BL1 */
+	boot_prof_import_prev();
+	BOOT_PROF_BEGIN(BOOT_PROF_STAGE, 0U);
+
 	/* Perform early platform-specific setup */
+	BOOT_PROF_BEGIN(BOOT_PROF_EARLY_PLAT_SETUP, 0U);
 	bl2_early_platform_setup2(arg0, arg1, arg2, arg3);
+	BOOT_PROF_END(BOOT_PROF_EARLY_PLAT_SETUP, 0U);
 
 	/* Perform late platform-specific setup */
+	BOOT_PROF_BEGIN(BOOT_PROF_PLAT_ARCH_SETUP, 0U);
 	bl2_plat_arch_setup();
+	BOOT_PROF_END(BOOT_PROF_PLAT_ARCH_SETUP, 0U);
 
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
@@ -57,11 +66,17 @@ void bl2_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 void bl2_el3_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 		   u_register_t arg3)
 {
+	BOOT_PROF_BEGIN(BOOT_PROF_STAGE, 0U);
+
 	/* Perform early platform-specific setup */
+	BOOT_PROF_BEGIN(BOOT_PROF_EARLY_PLAT_SETUP, 0U);
 	bl2_el3_early_platform_setup(arg0, arg1, arg2, arg3);
+	BOOT_PROF_END(BOOT_PROF_EARLY_PLAT_SETUP, 0U);
 
 	/* Perform late platform-specific setup */
+	BOOT_PROF_BEGIN(BOOT_PROF_PLAT_ARCH_SETUP, 0U);
 	bl2_el3_plat_arch_setup();
+	BOOT_PROF_END(BOOT_PROF_PLAT_ARCH_SETUP, 0U);
 
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
@@ -110,6 +125,13 @@ void bl2_main(void)
 	measured_boot_finish();
 #endif /* MEASURED_BOOT */
 
+	BOOT_PROF_END(BOOT_PROF_STAGE, 0U);
+
+	/* Pass the boot profile records on to BL31 */
+	if (GET_EL(next_bl_ep_info->spsr) == MODE_EL3) {
+		boot_prof_handoff(next_bl_ep_info);
+	}
+
 #if !BL2_AT_EL3
 #ifndef __aarch64__
 	/*
@@ -61,7 +61,8 @@ ifeq (${SDEI_SUPPORT},1)
 ifeq (${EL3_EXCEPTION_HANDLING},0)
   $(error EL3_EXCEPTION_HANDLING must be 1 for SDEI support)
 endif
-BL31_SOURCES		+=	services/std_svc/sdei/sdei_dispatch.S	\
+BL31_SOURCES		+=	lib/locks/exclusive/aarch64/rwlock.S	\
+				services/std_svc/sdei/sdei_dispatch.S	\
 				services/std_svc/sdei/sdei_event.c	\
 				services/std_svc/sdei/sdei_intr_mgmt.c	\
 				services/std_svc/sdei/sdei_main.c	\
@@ -73,6 +74,53 @@ BL31_SOURCES		+=	services/std_svc/trng/trng_main.c	\
 				services/std_svc/trng/trng_entropy_pool.c
 endif
 
+ifeq (${NS_SHARED_BUF_SUPPORT},1)
+BL31_SOURCES		+=	bl31/ns_buf.c
+endif
+
+ifeq (${ASYNC_CONSOLE},1)
+BL31_SOURCES		+=	drivers/console/console_async.c
+endif
+
+ifeq (${LOG_BINARY},1)
+ifeq (${ENABLE_PIE},1)
+  $(error LOG_BINARY is not supported with ENABLE_PIE)
+endif
+ifneq ($(findstring armlink,$(notdir $(LD))),)
+  $(error LOG_BINARY is not supported with armlink)
+endif
+endif
+
+ifeq (${SMC_MULTICALL_SUPPORT},1)
+ifeq (${NS_SHARED_BUF_SUPPORT},0)
+  $(error NS_SHARED_BUF_SUPPORT must be 1 for SMC_MULTICALL_SUPPORT)
+endif
+BL31_SOURCES		+=	services/el3/multicall.c
+endif
+
+ifeq (${ENABLE_LOCK_PROFILING},1)
+ifeq (${ENABLE_LTO},1)
+  $(error ENABLE_LOCK_PROFILING is not supported with ENABLE_LTO)
+endif
+ifneq ($(findstring armlink,$(notdir $(LD))),)
+  $(error ENABLE_LOCK_PROFILING is not supported with armlink)
+endif
+BL31_SOURCES		+=	lib/locks/lock_prof.c
+
+# Route every lock call through the profiler
+LOCK_PROF_WRAPPED	:=	spin_lock spin_unlock ticket_lock ticket_unlock \
+				bakery_lock_get bakery_lock_release
+ifneq ($(findstring gcc,$(notdir $(LD))),)
+BL31_LDFLAGS		+=	$(foreach f,${LOCK_PROF_WRAPPED},-Wl,--wrap=${f})
+else
+BL31_LDFLAGS		+=	$(foreach f,${LOCK_PROF_WRAPPED},--wrap=${f})
+endif
+endif
+
+ifneq ($(filter 1,${NS_SHARED_BUF_SUPPORT} ${SMC_MULTICALL_SUPPORT} ${ENABLE_LOCK_PROFILING}),)
+BL31_SOURCES		+=	services/el3/ven_el3_svc.c
+endif
+
 ifeq (${ENABLE_SPE_FOR_LOWER_ELS},1)
 BL31_SOURCES		+=	lib/extensions/spe/spe.c
 endif
@@ -95,6 +143,10 @@ BL31_SOURCES		+=	lib/cpus/aarch64/wa_cve_2017_5715_bpiall.S	\
 				lib/cpus/aarch64/wa_cve_2017_5715_mmu.S
 endif
 
+ifeq (${EL3_NO_AARCH32_LOWER_EL}-${CTX_INCLUDE_AARCH32_REGS},1-1)
+  $(error EL3_NO_AARCH32_LOWER_EL requires CTX_INCLUDE_AARCH32_REGS=0)
+endif
+
 BL31_LINKERFILE		:=	bl31/bl31.ld.S
 
 # Flag used to indicate if Crash reporting via console should be included
@@ -105,14 +157,28 @@ endif
 
 $(eval $(call assert_booleans,\
     $(sort \
+	ASYNC_CONSOLE \
+	CRASH_DUMP_MEM \
 	CRASH_REPORTING \
 	EL3_EXCEPTION_HANDLING \
+	EL3_NO_AARCH32_LOWER_EL \
+	ENABLE_LOCK_PROFILING \
+	LOG_BINARY \
+	NS_SHARED_BUF_SUPPORT \
 	SDEI_SUPPORT \
+	SMC_MULTICALL_SUPPORT \
 )))
 
 $(eval $(call add_defines,\
     $(sort \
+        ASYNC_CONSOLE \
+        CRASH_DUMP_MEM \
         CRASH_REPORTING \
         EL3_EXCEPTION_HANDLING \
+        EL3_NO_AARCH32_LOWER_EL \
+        ENABLE_LOCK_PROFILING \
+        LOG_BINARY \
+        NS_SHARED_BUF_SUPPORT \
         SDEI_SUPPORT \
+        SMC_MULTICALL_SUPPORT \
 )))
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,6 +16,7 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <drivers/console.h>
+#include <lib/boot_prof.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/pmf/pmf.h>
 #include <lib/runtime_instr.h>
@@ -79,11 +80,19 @@ void __init bl31_lib_init(void)
 void bl31_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 		u_register_t arg3)
 {
+	/* Start from the boot profile records of the previous images */
+	boot_prof_import_prev();
+	BOOT_PROF_BEGIN(BOOT_PROF_STAGE, 0U);
+
 	/* Perform early platform-specific setup */
+	BOOT_PROF_BEGIN(BOOT_PROF_EARLY_PLAT_SETUP, 0U);
 	bl31_early_platform_setup2(arg0, arg1, arg2, arg3);
+	BOOT_PROF_END(BOOT_PROF_EARLY_PLAT_SETUP, 0U);
 
 	/* Perform late platform-specific setup */
+	BOOT_PROF_BEGIN(BOOT_PROF_PLAT_ARCH_SETUP, 0U);
 	bl31_plat_arch_setup();
+	BOOT_PROF_END(BOOT_PROF_PLAT_ARCH_SETUP, 0U);
 
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
@@ -114,7 +123,9 @@ void bl31_main(void)
 #endif
 
 	/* Perform platform setup in BL31 */
+	BOOT_PROF_BEGIN(BOOT_PROF_PLAT_SETUP, 0U);
 	bl31_platform_setup();
+	BOOT_PROF_END(BOOT_PROF_PLAT_SETUP, 0U);
 
 	/* Initialise helper libraries */
 	bl31_lib_init();
@@ -126,7 +137,9 @@ void bl31_main(void)
 
 	/* Initialize the runtime services e.g. psci. */
 	INFO("BL31: Initializing runtime services\n");
+	BOOT_PROF_BEGIN(BOOT_PROF_RUNTIME_SVC_INIT, 0U);
 	runtime_svc_init();
+	BOOT_PROF_END(BOOT_PROF_RUNTIME_SVC_INIT, 0U);
 
 	/*
 	 * All the cold boot actions on the primary cpu are done. We now need to
@@ -144,7 +157,9 @@ void bl31_main(void)
 	if (bl32_init != NULL) {
 		INFO("BL31: Initializing BL32\n");
 
+		BOOT_PROF_BEGIN(BOOT_PROF_BL32_INIT, 0U);
 		int32_t rc = (*bl32_init)();
+		BOOT_PROF_END(BOOT_PROF_BL32_INIT, 0U);
 
 		if (rc == 0)
 			WARN("BL31: BL32 initialization failed\n");
@@ -155,6 +170,10 @@ void bl31_main(void)
 	 */
 	bl31_prepare_next_image_entry();
 
+	/* Report the duration of the cold boot steps of all the images. */
+	BOOT_PROF_END(BOOT_PROF_STAGE, 0U);
+	boot_prof_print();
+
 	console_flush();
 
 	/*
@@ -13,8 +13,8 @@
 #include <plat/common/platform.h>
 
 /*******************************************************************************
- * Local structure and corresponding array to keep track of the state of the
- * registered interrupt handlers for each interrupt type.
+ * Local structure and corresponding array to keep track of the routing model
+ * of each interrupt type.
  * The field descriptions are:
  *
  * 'scr_el3[2]'  : Mapping of the routing model in the 'flags' field to the
@@ -35,13 +35,19 @@
  *           All other bits are reserved and SBZ.
  ******************************************************************************/
 typedef struct intr_type_desc {
-	interrupt_type_handler_t handler;
 	u_register_t scr_el3[2];
 	uint32_t flags;
 } intr_type_desc_t;
 
 static intr_type_desc_t intr_type_descs[MAX_INTR_TYPES];
 
+/*******************************************************************************
+ * Registered handler for each interrupt type. This is kept as a plain array of
+ * function pointers so that the exception vectors can index it directly with
+ * the pending interrupt type, without calling get_interrupt_type_handler().
+ ******************************************************************************/
+interrupt_type_handler_t intr_type_handlers[MAX_INTR_TYPES];
+
 /*******************************************************************************
  * This function validates the interrupt type.
  ******************************************************************************/
@@ -150,7 +156,7 @@ int disable_intr_rm_local(uint32_t type, uint32_t security_state)
 {
 	uint32_t bit_pos, flag;
 
-	assert(intr_type_descs[type].handler != NULL);
+	assert(intr_type_handlers[type] != NULL);
 
 	flag = get_interrupt_rm_flag(INTR_DEFAULT_RM, security_state);
 
@@ -168,7 +174,7 @@ int enable_intr_rm_local(uint32_t type, uint32_t security_state)
 {
 	uint32_t bit_pos, flag;
 
-	assert(intr_type_descs[type].handler != NULL);
+	assert(intr_type_handlers[type] != NULL);
 
 	flag = get_interrupt_rm_flag(intr_type_descs[type].flags,
 				security_state);
@@ -199,7 +205,7 @@ int32_t register_interrupt_type_handler(uint32_t type,
 		return -EINVAL;
 
 	/* Check if a handler has already been registered */
-	if (intr_type_descs[type].handler != NULL)
+	if (intr_type_handlers[type] != NULL)
 		return -EALREADY;
 
 	rc = set_routing_model(type, flags);
@@ -207,7 +213,7 @@ int32_t register_interrupt_type_handler(uint32_t type,
 		return rc;
 
 	/* Save the handler */
-	intr_type_descs[type].handler = handler;
+	intr_type_handlers[type] = handler;
 
 	return 0;
 }
@@ -222,6 +228,6 @@ interrupt_type_handler_t get_interrupt_type_handler(uint32_t type)
 	if (validate_interrupt_type(type) != 0)
 		return NULL;
 
-	return intr_type_descs[type].handler;
+	return intr_type_handlers[type];
 }
 
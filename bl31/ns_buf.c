@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Per-CPU non-secure shared buffers.
+ *
+ * Each CPU may register one buffer of non-secure memory with EL3. The buffer is
+ * mapped once, at registration time, and stays mapped until the same CPU
+ * unregisters it. Runtime services can then exchange large structures with the
+ * caller through the accessors below without remapping memory or taking a
+ * global lock on every call: an SMC handler only ever touches the buffer of
+ * the CPU it is running on.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <bl31/ns_buf.h>
+#include <common/debug.h>
+#include <lib/spinlock.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+#include <plat/common/platform.h>
+#include <services/ven_el3_svc.h>
+#include <smccc_helpers.h>
+
+#include <platform_def.h>
+
+#if !PLAT_XLAT_TABLES_DYNAMIC
+#error "NS_SHARED_BUF_SUPPORT requires PLAT_XLAT_TABLES_DYNAMIC"
+#endif
+
+/*
+ * Largest buffer that a single CPU may register. Platforms that need more can
+ * override it from platform_def.h.
+ */
+#ifndef PLAT_NS_BUF_MAX_SIZE
+#define PLAT_NS_BUF_MAX_SIZE		(U(16) * PAGE_SIZE)
+#endif
+
+CASSERT((PLAT_NS_BUF_MAX_SIZE & PAGE_SIZE_MASK) == 0U,
+	assert_ns_buf_max_size_page_aligned);
+
+typedef struct ns_buf {
+	uintptr_t base_va;
+	unsigned long long base_pa;
+	size_t size;
+} __aligned(CACHE_WRITEBACK_GRANULE) ns_buf_t;
+
+static ns_buf_t ns_bufs[PLATFORM_CORE_COUNT];
+
+/* Serialises updates of the EL3 translation tables between CPUs */
+static spinlock_t ns_buf_map_lock;
+
+static inline ns_buf_t *this_cpu_ns_buf(void)
+{
+	return &ns_bufs[plat_my_core_pos()];
+}
+
+bool ns_buf_is_registered(void)
+{
+	return this_cpu_ns_buf()->size != 0U;
+}
+
+size_t ns_buf_size(void)
+{
+	return this_cpu_ns_buf()->size;
+}
+
+/*
+ * Return a pointer to 'len' bytes at 'offset' in the buffer of the calling
+ * CPU, or NULL if no buffer is registered or the range is out of bounds.
+ */
+void *ns_buf_ptr(size_t offset, size_t len)
+{
+	const ns_buf_t *buf = this_cpu_ns_buf();
+
+	if ((offset > buf->size) || (len > (buf->size - offset))) {
+		return NULL;
+	}
+
+	return (void *)(buf->base_va + offset);
+}
+
+int ns_buf_read(void *dst, size_t offset, size_t len)
+{
+	const void *src = ns_buf_ptr(offset, len);
+
+	if (src == NULL) {
+		return -EINVAL;
+	}
+
+	(void)memcpy(dst, src, len);
+
+	return 0;
+}
+
+int ns_buf_write(size_t offset, const void *src, size_t len)
+{
+	void *dst = ns_buf_ptr(offset, len);
+
+	if (dst == NULL) {
+		return -EINVAL;
+	}
+
+	(void)memcpy(dst, src, len);
+
+	return 0;
+}
+
+static int ns_buf_register(unsigned long long pa, size_t size)
+{
+	ns_buf_t *buf = this_cpu_ns_buf();
+	uintptr_t va;
+	int rc;
+
+	if (buf->size != 0U) {
+		return NS_BUF_E_DENIED;
+	}
+
+	if ((size == 0U) || (size > PLAT_NS_BUF_MAX_SIZE) ||
+	    ((pa & PAGE_SIZE_MASK) != 0U) || ((size & PAGE_SIZE_MASK) != 0U) ||
+	    ((pa + size - 1U) < pa)) {
+		return NS_BUF_E_INVALID_PARAMS;
+	}
+
+	/*
+	 * The buffer is mapped as cacheable memory, so it must not overlap
+	 * any device or memory that the Non-secure world can't access.
+	 */
+	if (plat_ns_buf_validate(pa, size) != 0) {
+		return NS_BUF_E_DENIED;
+	}
+
+	spin_lock(&ns_buf_map_lock);
+	rc = mmap_add_dynamic_region_alloc_va(pa, &va, size,
+					      MT_MEMORY | MT_RW | MT_NS |
+					      MT_EXECUTE_NEVER);
+	spin_unlock(&ns_buf_map_lock);
+
+	if (rc != 0) {
+		WARN("NS buffer: failed to map 0x%llx (%d)\n", pa, rc);
+		return (rc == -ENOMEM) ? NS_BUF_E_NO_MEMORY :
+					 NS_BUF_E_INVALID_PARAMS;
+	}
+
+	buf->base_va = va;
+	buf->base_pa = pa;
+	buf->size = size;
+
+	return NS_BUF_E_SUCCESS;
+}
+
+static int ns_buf_unregister(void)
+{
+	ns_buf_t *buf = this_cpu_ns_buf();
+	int rc;
+
+	if (buf->size == 0U) {
+		return NS_BUF_E_DENIED;
+	}
+
+	spin_lock(&ns_buf_map_lock);
+	rc = mmap_remove_dynamic_region(buf->base_va, buf->size);
+	spin_unlock(&ns_buf_map_lock);
+
+	if (rc != 0) {
+		WARN("NS buffer: failed to unmap 0x%llx (%d)\n",
+		     buf->base_pa, rc);
+		return NS_BUF_E_DENIED;
+	}
+
+	buf->base_va = 0U;
+	buf->base_pa = 0ULL;
+	buf->size = 0U;
+
+	return NS_BUF_E_SUCCESS;
+}
+
+uintptr_t ns_buf_smc_handler(uint32_t smc_fid,
+			     u_register_t x1,
+			     u_register_t x2,
+			     u_register_t x3,
+			     u_register_t x4,
+			     void *cookie,
+			     void *handle,
+			     u_register_t flags)
+{
+	/* The buffers are only meant to be shared with the normal world */
+	if (is_caller_secure(flags)) {
+		SMC_RET1(handle, NS_BUF_E_DENIED);
+	}
+
+	switch (smc_fid) {
+	case VEN_EL3_NS_BUF_REGISTER:
+		SMC_RET1(handle, ns_buf_register(x1, x2));
+
+	case VEN_EL3_NS_BUF_UNREGISTER:
+		SMC_RET1(handle, ns_buf_unregister());
+
+	case VEN_EL3_NS_BUF_INFO:
+		SMC_RET3(handle, NS_BUF_E_SUCCESS, PLAT_NS_BUF_MAX_SIZE,
+			 ns_buf_size());
+
+	default:
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
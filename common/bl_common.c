@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,6 +15,7 @@
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
 #include <drivers/io/io_storage.h>
+#include <lib/boot_prof.h>
 #include <lib/utils.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
 #include <plat/common/platform.h>
@@ -123,7 +124,9 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 
 	/* We have enough space so load the image now */
 	/* TODO: Consider whether to try to recover/retry a partially successful read */
+	BOOT_PROF_BEGIN(BOOT_PROF_IO_READ, image_id);
 	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
+	BOOT_PROF_END(BOOT_PROF_IO_READ, image_id);
 	if ((io_result != 0) || (bytes_read < image_size)) {
 		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
 		goto exit;
@@ -190,9 +193,11 @@ static int load_auth_image_recursive(unsigned int image_id,
 	}
 
 	/* Authenticate it */
+	BOOT_PROF_BEGIN(BOOT_PROF_AUTH, image_id);
 	rc = auth_mod_verify_img(image_id,
 				 (void *)image_data->image_base,
 				 image_data->image_size);
+	BOOT_PROF_END(BOOT_PROF_AUTH, image_id);
 	if (rc != 0) {
 		/* Authentication error, zero memory and flush it right away. */
 		zero_normalmem((void *)image_data->image_base,
@@ -239,10 +244,14 @@ int load_auth_image(unsigned int image_id, image_info_t *image_data)
 {
 	int err;
 
+	BOOT_PROF_BEGIN(BOOT_PROF_LOAD_IMAGE, image_id);
+
 	do {
 		err = load_auth_image_internal(image_id, image_data);
 	} while ((err != 0) && (plat_try_next_boot_source() != 0));
 
+	BOOT_PROF_END(BOOT_PROF_LOAD_IMAGE, image_id);
+
 	return err;
 }
 
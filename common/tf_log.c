@@ -1,18 +1,34 @@
 /*
- * Copyright (c) 2017-2019, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <stdarg.h>
 #include <assert.h>
+#include <stddef.h>
 #include <stdio.h>
 
+#include <arch_helpers.h>
 #include <common/debug.h>
+#if LOG_BINARY && IMAGE_BL31
+#include <common/tf_log_bin.h>
+#endif
 #include <plat/common/platform.h>
 
-/* Set the default maximum log level to the `LOG_LEVEL` build flag */
-static unsigned int max_log_level = LOG_LEVEL;
+/*
+ * Log output above the level of a source file is compiled out, so start from
+ * the highest level compiled into any of them and don't filter anything.
+ */
+static unsigned int max_log_level = LOG_LEVEL_MAX;
+
+#if LOG_BINARY && IMAGE_BL31
+/*
+ * Log records, see tf_log_bin.h for their layout. The header is filled in on
+ * first use so that the buffer stays out of the image.
+ */
+tf_log_bin_t tf_log_bin_buf;
+#endif
 
 /*
  * The common log function which is invoked by TF-A code.
@@ -49,17 +65,74 @@ void tf_log(const char *fmt, ...)
 	va_end(args);
 }
 
+#if LOG_BINARY && IMAGE_BL31
+/*
+ * The log function which is invoked by the log macros defined in debug.h in
+ * binary mode. It appends a record made of the identifier of the format string,
+ * the system counter and the 'nargs' arguments to the ring of the calling CPU,
+ * dropping the oldest records to make space if needed.
+ */
+void tf_log_bin(unsigned int log_level, uintptr_t fmt_id, unsigned int nargs,
+		...)
+{
+	tf_log_bin_ring_t *ring;
+	unsigned int len = nargs + TF_LOG_BIN_REC_HDR_WORDS;
+	uint64_t head;
+	va_list args;
+
+	assert((log_level > 0U) && (log_level <= LOG_LEVEL_VERBOSE));
+	assert(nargs <= TF_LOG_BIN_MAX_ARGS);
+
+	if (log_level > max_log_level)
+		return;
+
+	if (tf_log_bin_buf.magic != TF_LOG_BIN_MAGIC) {
+		tf_log_bin_buf.version = TF_LOG_BIN_VERSION;
+		tf_log_bin_buf.num_cpus = PLATFORM_CORE_COUNT;
+		tf_log_bin_buf.ring_words = TF_LOG_BIN_RING_WORDS;
+		tf_log_bin_buf.cpus_offset = offsetof(tf_log_bin_t, cpus);
+		tf_log_bin_buf.ring_size = sizeof(tf_log_bin_ring_t);
+		tf_log_bin_buf.magic = TF_LOG_BIN_MAGIC;
+	}
+
+	ring = &tf_log_bin_buf.cpus[plat_my_core_pos()];
+	head = ring->head;
+
+	while ((head + len - ring->tail) > TF_LOG_BIN_RING_WORDS) {
+		ring->tail += TF_LOG_BIN_REC_HDR_WORDS +
+			(ring->words[ring->tail % TF_LOG_BIN_RING_WORDS] &
+			 TF_LOG_BIN_REC_NARGS_MASK);
+	}
+
+	ring->words[head++ % TF_LOG_BIN_RING_WORDS] =
+		((uint64_t)fmt_id << TF_LOG_BIN_REC_FMT_SHIFT) | nargs;
+	ring->words[head++ % TF_LOG_BIN_RING_WORDS] = read_cntpct_el0();
+
+	va_start(args, nargs);
+	while (nargs-- > 0U) {
+		ring->words[head++ % TF_LOG_BIN_RING_WORDS] =
+			va_arg(args, u_register_t);
+	}
+	va_end(args);
+
+	ring->head = head;
+}
+#endif /* LOG_BINARY && IMAGE_BL31 */
+
 /*
  * The helper function to set the log level dynamically by platform. The
- * maximum log level is determined by `LOG_LEVEL` build flag at compile time
- * and this helper can set a lower (or equal) log level than the one at compile.
+ * maximum log level of each source file is determined at compile time by the
+ * `LOG_LEVEL` and `LOG_LEVEL_MODULES` build flags, and this helper can only
+ * filter out more of the log output: a level above the highest of them is
+ * ignored.
  */
 void tf_log_set_max_level(unsigned int log_level)
 {
 	assert(log_level <= LOG_LEVEL_VERBOSE);
 	assert((log_level % 10U) == 0U);
 
-	/* Cap log_level to the compile time maximum. */
-	if (log_level <= (unsigned int)LOG_LEVEL)
+	/* Cap log_level to the highest level compiled in */
+	if (log_level <= (unsigned int)LOG_LEVEL_MAX) {
 		max_log_level = log_level;
+	}
 }
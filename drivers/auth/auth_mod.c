@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,6 +16,7 @@
 #include <drivers/auth/auth_mod.h>
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/auth/img_parser_mod.h>
+#include <lib/boot_prof.h>
 #include <lib/fconf/fconf_tbbr_getter.h>
 #include <plat/common/platform.h>
 
@@ -111,8 +112,10 @@ static int auth_hash(const auth_method_param_hash_t *param,
 	return_if_error(rc);
 
 	/* Ask the crypto module to verify this hash */
+	BOOT_PROF_BEGIN(BOOT_PROF_HASH, img_desc->img_id);
 	rc = crypto_mod_verify_hash(data_ptr, data_len,
 				    hash_der_ptr, hash_der_len);
+	BOOT_PROF_END(BOOT_PROF_HASH, img_desc->img_id);
 
 	return rc;
 }
@@ -191,10 +194,12 @@ static int auth_signature(const auth_method_param_sig_t *param,
 		return_if_error(rc);
 
 		/* Ask the crypto module to verify the signature */
+		BOOT_PROF_BEGIN(BOOT_PROF_SIG_VERIFY, img_desc->img_id);
 		rc = crypto_mod_verify_signature(data_ptr, data_len,
 						 sig_ptr, sig_len,
 						 sig_alg_ptr, sig_alg_len,
 						 pk_ptr, pk_len);
+		BOOT_PROF_END(BOOT_PROF_SIG_VERIFY, img_desc->img_id);
 		return_if_error(rc);
 
 		if (flags & ROTPK_NOT_DEPLOYED) {
@@ -202,15 +207,19 @@ static int auth_signature(const auth_method_param_sig_t *param,
 				"Skipping ROTPK verification.\n");
 		} else {
 			/* Ask the crypto-module to verify the key hash */
+			BOOT_PROF_BEGIN(BOOT_PROF_HASH, img_desc->img_id);
 			rc = crypto_mod_verify_hash(pk_ptr, pk_len,
 				    pk_hash_ptr, pk_hash_len);
+			BOOT_PROF_END(BOOT_PROF_HASH, img_desc->img_id);
 		}
 	} else {
 		/* Ask the crypto module to verify the signature */
+		BOOT_PROF_BEGIN(BOOT_PROF_SIG_VERIFY, img_desc->img_id);
 		rc = crypto_mod_verify_signature(data_ptr, data_len,
 						 sig_ptr, sig_len,
 						 sig_alg_ptr, sig_alg_len,
 						 pk_ptr, pk_len);
+		BOOT_PROF_END(BOOT_PROF_SIG_VERIFY, img_desc->img_id);
 	}
 
 	return rc;
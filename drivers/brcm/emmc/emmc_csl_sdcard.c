@@ -129,28 +129,28 @@ int set_card_data_width(struct sd_handle *handle, int width)
 #ifdef DRIVER_EMMC_ENABLE_DATA_WIDTH_8BIT
 	case SD_BUS_DATA_WIDTH_8BIT:
 		data_width = SD_MMC_8BIT_MODE;
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 		bitwidth_str = "8_BIT";
 #endif
 		break;
 #endif
 	case SD_BUS_DATA_WIDTH_4BIT:
 		data_width = SD_MMC_4BIT_MODE;
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 		bitwidth_str = "4_BIT";
 #endif
 		break;
 
 	case SD_BUS_DATA_WIDTH_1BIT:
 		data_width = SD_MMC_1BIT_MODE;
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 		bitwidth_str = "1_BIT";
 #endif
 		break;
 
 	default:
 		is_valid_arg = 0;
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 		bitwidth_str = "unknown";
 #endif
 		break;
@@ -159,19 +159,19 @@ int set_card_data_width(struct sd_handle *handle, int width)
 	if (is_valid_arg) {
 		rc = mmc_cmd6(handle, data_width);
 		if (rc == SD_OK) {
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 			result_str = "succeeded";
 #endif
 			chal_sd_config_bus_width((CHAL_HANDLE *) handle->device,
 						 width);
 		} else {
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 			result_str = "failed";
 #endif
 		}
 	} else {
 		rc = SD_FAIL;
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 		result_str = "ignored";
 #endif
 	}
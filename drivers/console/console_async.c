@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Buffered console output for BL31 at runtime.
+ *
+ * Once the console state is CONSOLE_FLAG_RUNTIME, console_putc() appends the
+ * characters to a ring private to the calling CPU instead of waiting for the
+ * consoles to accept them. The rings are written out:
+ *
+ * - by each CPU before it returns from an SMC, from its own ring, as many
+ *   characters as the consoles can take without waiting, see console_tx_space();
+ * - a few characters at a time, by each CPU from its own ring when it is full;
+ * - a few characters at a time, from any ring, by PSCI before a CPU is turned
+ *   off or suspended;
+ * - entirely, by console_flush(), and so on panics and failed assertions.
+ *
+ * Only the owning CPU appends to a ring, so that doesn't need any lock. The
+ * rings are drained with a lock held, so that the output of a ring isn't
+ * interleaved with itself. Except in console_flush(), the number of characters
+ * written with the lock held is bounded by PLAT_CONSOLE_DRAIN_BUDGET, so that
+ * neither the draining CPU nor the ones waiting for the lock are delayed by
+ * more than the time it takes to send that many characters.
+ */
+
+#include <limits.h>
+#include <stdbool.h>
+
+#include <arch.h>
+#include <arch_helpers.h>
+#include <drivers/console.h>
+#include <lib/cassert.h>
+#include <lib/spinlock.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+#include <platform_def.h>
+
+#ifndef PLAT_CONSOLE_RING_SIZE
+#define PLAT_CONSOLE_RING_SIZE		U(1024)
+#endif
+
+/*
+ * Bounds the time a CPU spends writing out the rings with the lock held. Most
+ * UARTs take much longer to send that many characters than their FIFO holds.
+ */
+#ifndef PLAT_CONSOLE_DRAIN_BUDGET
+#define PLAT_CONSOLE_DRAIN_BUDGET	U(32)
+#endif
+
+CASSERT(PLAT_CONSOLE_DRAIN_BUDGET != 0U, assert_console_drain_budget_zero);
+CASSERT(IS_POWER_OF_TWO(PLAT_CONSOLE_RING_SIZE),
+	assert_console_ring_size_power_of_two);
+
+typedef struct console_ring {
+	/* Number of characters ever appended, only written by the owner */
+	volatile unsigned int head;
+	/* Number of characters ever drained, only written with the lock held */
+	volatile unsigned int tail;
+	char buf[PLAT_CONSOLE_RING_SIZE];
+} __aligned(CACHE_WRITEBACK_GRANULE) console_ring_t;
+
+static console_ring_t console_rings[PLATFORM_CORE_COUNT];
+static spinlock_t console_rings_lock;
+/* Ring console_async_drain_bounded() starts from, protected by the lock */
+static unsigned int console_rings_next;
+
+/*
+ * The rings and their lock are only coherent between CPUs which have their
+ * data cache enabled. That isn't the case early in the cold boot, or on a CPU
+ * going through the power down sequence.
+ */
+static bool console_rings_usable(void)
+{
+	return (read_sctlr_el3() & SCTLR_C_BIT) != 0U;
+}
+
+/*
+ * Writes at most 'budget' characters of the ring to the consoles, with the lock
+ * held, and stops before the consoles would have to wait once 'space' runs out,
+ * where a '\n' counts as two. Returns the number of characters written.
+ */
+static unsigned int console_ring_drain(console_ring_t *ring,
+				       unsigned int budget, unsigned int space)
+{
+	unsigned int tail = ring->tail;
+	unsigned int head = ring->head;
+	unsigned int count;
+	char c;
+
+	/* Read the characters only after the head which covers them. */
+	dmbish();
+
+	if ((head - tail) > budget)
+		head = tail + budget;
+
+	for (count = 0U; tail != head; count++) {
+		c = ring->buf[tail & (PLAT_CONSOLE_RING_SIZE - 1U)];
+		if (space < ((c == '\n') ? 2U : 1U))
+			break;
+		space -= (c == '\n') ? 2U : 1U;
+
+		(void)console_putc_sync(c);
+		tail++;
+	}
+
+	/* Give the space back only once the characters have been read. */
+	dmbish();
+	ring->tail = tail;
+
+	return count;
+}
+
+static bool console_rings_empty(void)
+{
+	for (unsigned int i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		if (console_rings[i].head != console_rings[i].tail)
+			return false;
+	}
+
+	return true;
+}
+
+void console_async_drain(void)
+{
+	if (!console_rings_usable() || console_rings_empty())
+		return;
+
+	spin_lock(&console_rings_lock);
+	for (unsigned int i = 0U; i < PLATFORM_CORE_COUNT; i++)
+		(void)console_ring_drain(&console_rings[i], UINT_MAX,
+					 UINT_MAX);
+	spin_unlock(&console_rings_lock);
+}
+
+void console_async_drain_bounded(void)
+{
+	unsigned int budget = PLAT_CONSOLE_DRAIN_BUDGET;
+	unsigned int i, n;
+
+	/* Don't take the lock on the idle path when there is nothing to do. */
+	if (!console_rings_usable() || console_rings_empty())
+		return;
+
+	spin_lock(&console_rings_lock);
+
+	/*
+	 * Start from the ring after the last one that was drained, so that a
+	 * CPU that keeps logging doesn't delay the output of the others.
+	 */
+	i = console_rings_next;
+	for (n = 0U; (n < PLATFORM_CORE_COUNT) && (budget != 0U); n++) {
+		budget -= console_ring_drain(&console_rings[i], budget,
+					     UINT_MAX);
+		i = (i + 1U) % PLATFORM_CORE_COUNT;
+	}
+	console_rings_next = i;
+
+	spin_unlock(&console_rings_lock);
+}
+
+void console_async_drain_local(void)
+{
+	console_ring_t *ring;
+
+	if (!console_rings_usable())
+		return;
+
+	ring = &console_rings[plat_my_core_pos()];
+	if (ring->head == ring->tail)
+		return;
+
+	/*
+	 * This runs on every SMC return with the interrupts masked, so only
+	 * write what the consoles can take at once. If a console can't tell how
+	 * much that is, the ring is only written out by the PSCI idle points,
+	 * by console_flush() and when it is full.
+	 */
+	spin_lock(&console_rings_lock);
+	(void)console_ring_drain(ring, PLAT_CONSOLE_DRAIN_BUDGET,
+				 (unsigned int)console_tx_space());
+	spin_unlock(&console_rings_lock);
+}
+
+int console_async_putc(int c)
+{
+	console_ring_t *ring;
+	unsigned int head;
+
+	if (!console_rings_usable())
+		return console_putc_sync(c);
+
+	ring = &console_rings[plat_my_core_pos()];
+	head = ring->head;
+
+	/* When the ring is full, wait for the consoles to make some space. */
+	if ((head - ring->tail) == PLAT_CONSOLE_RING_SIZE) {
+		spin_lock(&console_rings_lock);
+		(void)console_ring_drain(ring, PLAT_CONSOLE_DRAIN_BUDGET,
+					 UINT_MAX);
+		spin_unlock(&console_rings_lock);
+	}
+
+	/* Don't overwrite the slot before the tail showing it is free. */
+	dmbish();
+	ring->buf[head & (PLAT_CONSOLE_RING_SIZE - 1U)] = (char)c;
+
+	/* Publish the character before the head which covers it. */
+	dmbish();
+	ring->head = head + 1U;
+
+	return c;
+}
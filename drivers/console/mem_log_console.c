@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <string.h>
+
+#include <arch_helpers.h>
+#include <drivers/console.h>
+#include <drivers/mem_log_console.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+#include <platform_def.h>
+
+/* Rings are kept 8-byte aligned, and must hold some text after their header */
+#define MEM_LOG_RING_ALIGN	U(8)
+#define MEM_LOG_RING_MIN_SIZE	(sizeof(mem_log_ring_t) + U(64))
+
+static int console_mem_log_putc(int character, console_t *console)
+{
+	console_mem_log_t *mem_log = (console_mem_log_t *)console;
+	size_t text_size = mem_log->ring_size - sizeof(mem_log_ring_t);
+	uintptr_t ring_base = console->base + sizeof(mem_log_hdr_t) +
+		(plat_my_core_pos() * mem_log->ring_size);
+	mem_log_ring_t *ring = (mem_log_ring_t *)ring_base;
+	char *text = (char *)(ring_base + sizeof(mem_log_ring_t));
+	uint64_t head = ring->head;
+
+	text[head % text_size] = (char)character;
+
+	/* Make the character visible before the head which covers it. */
+	dmbst();
+	ring->head = head + 1U;
+
+	return character;
+}
+
+/* The ring overwrites its oldest text, so writing never waits. */
+static int console_mem_log_tx_space(console_t *console)
+{
+	return INT_MAX;
+}
+
+static const console_t console_mem_log_template = {
+	.flags = CONSOLE_FLAG_BOOT | CONSOLE_FLAG_CRASH,
+	.putc = console_mem_log_putc,
+	.tx_space = console_mem_log_tx_space,
+};
+
+int console_mem_log_register(uintptr_t base, size_t size,
+			     console_mem_log_t *console)
+{
+	mem_log_hdr_t *hdr = (mem_log_hdr_t *)base;
+	size_t ring_size;
+	unsigned int i;
+
+	assert((base % MEM_LOG_RING_ALIGN) == 0U);
+
+	if (size < sizeof(mem_log_hdr_t))
+		return 0;
+
+	ring_size = (size - sizeof(mem_log_hdr_t)) / PLATFORM_CORE_COUNT;
+	ring_size &= ~(size_t)(MEM_LOG_RING_ALIGN - 1U);
+	if (ring_size < MEM_LOG_RING_MIN_SIZE)
+		return 0;
+
+	if ((hdr->magic == MEM_LOG_MAGIC) &&
+	    (hdr->version == MEM_LOG_VERSION) &&
+	    (hdr->num_cpus == PLATFORM_CORE_COUNT) &&
+	    (hdr->ring_size == ring_size)) {
+		/* Keep the logs of the previous boots. */
+		hdr->boot_count++;
+	} else {
+		hdr->magic = 0U;
+		dmbst();
+
+		for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+			mem_log_ring_t *ring = (mem_log_ring_t *)(base +
+				sizeof(mem_log_hdr_t) + (i * ring_size));
+
+			ring->head = 0U;
+			ring->reserved = 0U;
+		}
+
+		hdr->version = MEM_LOG_VERSION;
+		hdr->num_cpus = PLATFORM_CORE_COUNT;
+		hdr->ring_size = (uint32_t)ring_size;
+		hdr->boot_count = 1U;
+		dmbst();
+		hdr->magic = MEM_LOG_MAGIC;
+	}
+
+	/* The callbacks of a console_t are const, so initialise it by copy. */
+	(void)memcpy(&console->console, &console_mem_log_template,
+		     sizeof(console_t));
+	console->console.base = base;
+	console->ring_size = ring_size;
+
+	return console_register(&console->console);
+}
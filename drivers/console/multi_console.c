@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -84,7 +84,7 @@ static int do_putc(int c, console_t *console)
 	return console->putc(c, console);
 }
 
-int console_putc(int c)
+int console_putc_sync(int c)
 {
 	int err = ERROR_NO_VALID_CONSOLE;
 	console_t *console;
@@ -99,6 +99,47 @@ int console_putc(int c)
 	return err;
 }
 
+int console_putc(int c)
+{
+#if ASYNC_CONSOLE && IMAGE_BL31
+	if (console_state == CONSOLE_FLAG_RUNTIME)
+		return console_async_putc(c);
+#endif
+
+	return console_putc_sync(c);
+}
+
+int console_write(const char *buf, size_t len)
+{
+	int err = ERROR_NO_VALID_CONSOLE;
+	console_t *console;
+	size_t i;
+
+	if (len == 0U)
+		return 0;
+
+#if ASYNC_CONSOLE && IMAGE_BL31
+	if (console_state == CONSOLE_FLAG_RUNTIME) {
+		for (i = 0U; i < len; i++)
+			(void)console_async_putc((unsigned char)buf[i]);
+		return 0;
+	}
+#endif
+
+	for (console = console_list; console != NULL; console = console->next)
+		if ((console->flags & console_state) && (console->putc != NULL)) {
+			int ret = 0;
+
+			for (i = 0U; (i < len) && (ret >= 0); i++)
+				ret = do_putc((unsigned char)buf[i], console);
+
+			if ((err == ERROR_NO_VALID_CONSOLE) || (ret < err))
+				err = (ret < 0) ? ret : 0;
+		}
+
+	return err;
+}
+
 int console_getc(void)
 {
 	int err = ERROR_NO_VALID_CONSOLE;
@@ -119,10 +160,30 @@ int console_getc(void)
 	return err;
 }
 
+int console_tx_space(void)
+{
+	int space = ERROR_NO_VALID_CONSOLE;
+	console_t *console;
+
+	for (console = console_list; console != NULL; console = console->next)
+		if ((console->flags & console_state) && (console->putc != NULL)) {
+			int ret = 0;
+
+			if (console->tx_space != NULL)
+				ret = console->tx_space(console);
+			if ((space == ERROR_NO_VALID_CONSOLE) || (ret < space))
+				space = ret;
+		}
+
+	return (space < 0) ? 0 : space;
+}
+
 void console_flush(void)
 {
 	console_t *console;
 
+	console_async_drain();
+
 	for (console = console_list; console != NULL; console = console->next)
 		if ((console->flags & console_state) && (console->flush != NULL)) {
 			console->flush(console);
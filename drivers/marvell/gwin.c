@@ -15,7 +15,7 @@
 #include <mvebu.h>
 #include <mvebu_def.h>
 
-#if LOG_LEVEL >= LOG_LEVEL_INFO
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_INFO
 #define DEBUG_ADDR_MAP
 #endif
 
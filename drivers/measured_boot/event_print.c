@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2020-2021, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -10,7 +10,7 @@
 #include <common/debug.h>
 #include <drivers/measured_boot/event_log.h>
 
-#if LOG_LEVEL >= EVENT_LOG_LEVEL
+#if LOG_LEVEL_THIS_FILE >= EVENT_LOG_LEVEL
 
 /*
  * Print TCG_EfiSpecIDEventStruct
@@ -242,7 +242,7 @@ static void event2_print(uint8_t **log_addr, size_t *log_size)
 	*log_size -= (uintptr_t)ptr + event_size - (uintptr_t)*log_addr;
 	*log_addr = (uint8_t *)ptr + event_size;
 }
-#endif	/* LOG_LEVEL >= EVENT_LOG_LEVEL */
+#endif	/* LOG_LEVEL_THIS_FILE >= EVENT_LOG_LEVEL */
 
 /*
  * Print Event Log
@@ -252,7 +252,7 @@ static void event2_print(uint8_t **log_addr, size_t *log_size)
  */
 void dump_event_log(uint8_t *log_addr, size_t log_size)
 {
-#if LOG_LEVEL >= EVENT_LOG_LEVEL
+#if LOG_LEVEL_THIS_FILE >= EVENT_LOG_LEVEL
 	assert(log_addr != NULL);
 
 	/* Print TCG_EfiSpecIDEvent */
@@ -20,7 +20,7 @@
 
 #include <mentor_i2c_plat.h>
 
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 #define DEBUG_I2C
 #endif
 
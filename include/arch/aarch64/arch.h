@@ -200,6 +200,10 @@
 #define ID_AA64ISAR0_RNDR_SHIFT U(60)
 #define ID_AA64ISAR0_RNDR_MASK  ULL(0xf)
 
+#define ID_AA64ISAR0_TLB_SHIFT		U(56)
+#define ID_AA64ISAR0_TLB_MASK		ULL(0xf)
+#define ID_AA64ISAR0_TLB_RANGE		ULL(0x2)
+
 /* ID_AA64ISAR1_EL1 definitions */
 #define ID_AA64ISAR1_EL1	S3_0_C0_C6_1
 #define ID_AA64ISAR1_GPI_SHIFT	U(28)
@@ -793,6 +797,19 @@
 #define TLBI_ADDR_MASK		ULL(0x00000FFFFFFFFFFF)
 #define TLBI_ADDR(x)		(((x) >> TLBI_ADDR_SHIFT) & TLBI_ADDR_MASK)
 
+/*
+ * Operand of the TLBI range operations, for the 4KB granule. Each operation
+ * covers (NUM + 1) * 2^(5 * SCALE + 1) pages starting at BaseADDR.
+ */
+#define TLBIR_TG_4KB		(ULL(1) << 46)
+#define TLBIR_SCALE_SHIFT	U(44)
+#define TLBIR_NUM_SHIFT		U(39)
+#define TLBIR_NUM_MASK		ULL(0x1f)
+#define TLBIR_BADDR_MASK	ULL(0x1FFFFFFFFF)
+#define TLBIR_SCALE_MAX		U(3)
+#define TLBIR_MAX_PAGES		\
+	((TLBIR_NUM_MASK + ULL(1)) << ((U(5) * TLBIR_SCALE_MAX) + U(1)))
+
 /*******************************************************************************
  * Definitions of register offsets and fields in the CNTCTLBase Frame of the
  * system level implementation of the Generic Timer.
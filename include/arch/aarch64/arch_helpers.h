@@ -142,6 +142,7 @@ DEFINE_SYSOP_TYPE_FUNC(tlbi, alle2is)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle3)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle3is)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1)
+DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1is)
 #elif ERRATA_A76_1286807
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle1)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle1is)
@@ -150,6 +151,7 @@ DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle2is)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle3)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle3is)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(vmalle1)
+DEFINE_TLBIOP_ERRATA_TYPE_FUNC(vmalle1is)
 #else
 DEFINE_SYSOP_TYPE_FUNC(tlbi, alle1)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, alle1is)
@@ -158,6 +160,7 @@ DEFINE_SYSOP_TYPE_FUNC(tlbi, alle2is)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, alle3)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, alle3is)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1)
+DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1is)
 #endif
 
 #if ERRATA_A57_813419
@@ -183,6 +186,20 @@ DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vae3is)
 DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vale3is)
 #endif
 
+/*
+ * TLBI range operations, from Armv8.4. They are encoded as SYS instructions so
+ * that they can be built when targeting an earlier version of the architecture.
+ */
+#define DEFINE_TLBIOP_RANGE_FUNC(_type, _op1, _op2)			\
+static inline void tlbi ## _type(uint64_t v)				\
+{									\
+	__asm__("sys #" #_op1 ", c8, c2, #" #_op2 ", %0" : : "r" (v));	\
+}
+
+DEFINE_TLBIOP_RANGE_FUNC(rvaae1is, 0, 3)
+DEFINE_TLBIOP_RANGE_FUNC(rvae2is, 4, 1)
+DEFINE_TLBIOP_RANGE_FUNC(rvae3is, 6, 1)
+
 /*******************************************************************************
  * Cache maintenance accessor prototypes
  ******************************************************************************/
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CRASH_DUMP_H
+#define CRASH_DUMP_H
+
+#include <lib/utils_def.h>
+
+/*
+ * Layout of the crash dump region. The region starts with a header, followed
+ * by a ring of fixed-size crash records. Records are claimed in sequence and
+ * the oldest one is overwritten once the ring is full. All multi-byte fields
+ * are little-endian. This layout is also what tools/crashdump decodes, so any
+ * change must bump CRASH_DUMP_VERSION.
+ */
+#define CRASH_DUMP_MAGIC		U(0x44434654)	/* "TFCD" */
+#define CRASH_DUMP_VERSION		U(1)
+
+/* Header */
+#define CRASH_DUMP_HDR_MAGIC		U(0x0)
+#define CRASH_DUMP_HDR_VERSION		U(0x4)
+#define CRASH_DUMP_HDR_REC_SIZE		U(0x8)
+#define CRASH_DUMP_HDR_NUM_RECS		U(0xc)
+#define CRASH_DUMP_HDR_NEXT_SEQ		U(0x10)
+#define CRASH_DUMP_HDR_SIZE		U(0x40)
+
+/* Reason for the crash */
+#define CRASH_REASON_PANIC		U(0)
+#define CRASH_REASON_UNHANDLED_EXCEPTION	U(1)
+#define CRASH_REASON_UNHANDLED_INTERRUPT	U(2)
+
+/* Number of return addresses kept from the frame record chain */
+#define CRASH_DUMP_BT_DEPTH		U(16)
+
+/* Number of registers of each class saved in a record */
+#define CRASH_DUMP_NUM_GPREGS		U(31)	/* x0 - x30 */
+#define CRASH_DUMP_NUM_EL3_REGS		U(11)
+#define CRASH_DUMP_NUM_NON_EL3_REGS	U(33)
+
+/* Record. It is only valid when its magic field holds CRASH_RECORD_MAGIC */
+#define CRASH_RECORD_MAGIC		U(0x52434654)	/* "TFCR" */
+#define CRASH_REC_MAGIC			U(0x0)
+#define CRASH_REC_REASON		U(0x4)
+#define CRASH_REC_SEQ			U(0x8)
+#define CRASH_REC_MPIDR			U(0x10)
+#define CRASH_REC_CNTPCT		U(0x18)
+#define CRASH_REC_GPREGS		U(0x20)
+#define CRASH_REC_EL3_REGS		(CRASH_REC_GPREGS + \
+					 (CRASH_DUMP_NUM_GPREGS * U(8)))
+#define CRASH_REC_NON_EL3_REGS		(CRASH_REC_EL3_REGS + \
+					 (CRASH_DUMP_NUM_EL3_REGS * U(8)))
+#define CRASH_REC_BT_COUNT		(CRASH_REC_NON_EL3_REGS + \
+					 (CRASH_DUMP_NUM_NON_EL3_REGS * U(8)))
+#define CRASH_REC_BT			(CRASH_REC_BT_COUNT + U(8))
+#define CRASH_DUMP_REC_SIZE		U(0x300)
+
+/* Offset of PAR_EL1, which the backtrace walk clobbers, in the record */
+#define CRASH_REC_PAR_EL1		(CRASH_REC_NON_EL3_REGS + U(20 * 8))
+
+#if CRASH_DUMP_MEM
+
+#if !defined(PLAT_CRASH_DUMP_BASE) || !defined(PLAT_CRASH_DUMP_SIZE)
+#error "CRASH_DUMP_MEM requires PLAT_CRASH_DUMP_BASE and PLAT_CRASH_DUMP_SIZE"
+#endif
+
+#define CRASH_DUMP_NUM_RECS		((PLAT_CRASH_DUMP_SIZE - \
+					  CRASH_DUMP_HDR_SIZE) / \
+					 CRASH_DUMP_REC_SIZE)
+
+#if CRASH_DUMP_NUM_RECS == 0
+#error "PLAT_CRASH_DUMP_SIZE is too small to hold a crash record"
+#endif
+
+#endif /* CRASH_DUMP_MEM */
+
+#endif /* CRASH_DUMP_H */
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef NS_BUF_H
+#define NS_BUF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+#include <services/ven_el3_svc.h>
+
+#define NS_BUF_NUM_SMC_CALLS		U(3)
+
+/* Error codes returned to the caller of the NS buffer SMCs */
+#define NS_BUF_E_SUCCESS		0
+#define NS_BUF_E_NOT_SUPPORTED		-1
+#define NS_BUF_E_INVALID_PARAMS		-2
+#define NS_BUF_E_DENIED			-3
+#define NS_BUF_E_NO_MEMORY		-4
+
+#if NS_SHARED_BUF_SUPPORT
+
+static inline bool is_ns_buf_fid(uint32_t smc_fid)
+{
+	return (smc_fid == VEN_EL3_NS_BUF_REGISTER) ||
+	       (smc_fid == VEN_EL3_NS_BUF_UNREGISTER) ||
+	       (smc_fid == VEN_EL3_NS_BUF_INFO);
+}
+
+/*
+ * Accessors for the non-secure buffer registered by the calling CPU. They
+ * must only be called from an SMC handler running on that CPU, in which case
+ * no locking is needed. All offsets and lengths are checked against the
+ * registered size.
+ */
+bool ns_buf_is_registered(void);
+size_t ns_buf_size(void);
+void *ns_buf_ptr(size_t offset, size_t len);
+int ns_buf_read(void *dst, size_t offset, size_t len);
+int ns_buf_write(size_t offset, const void *src, size_t len);
+
+#else
+
+static inline bool is_ns_buf_fid(uint32_t smc_fid)
+{
+	return false;
+}
+
+static inline bool ns_buf_is_registered(void)
+{
+	return false;
+}
+
+static inline size_t ns_buf_size(void)
+{
+	return 0U;
+}
+
+static inline void *ns_buf_ptr(size_t offset, size_t len)
+{
+	return NULL;
+}
+
+#endif /* NS_SHARED_BUF_SUPPORT */
+
+uintptr_t ns_buf_smc_handler(uint32_t smc_fid,
+			     u_register_t x1,
+			     u_register_t x2,
+			     u_register_t x3,
+			     u_register_t x4,
+			     void *cookie,
+			     void *handle,
+			     u_register_t flags);
+
+#endif /* NS_BUF_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -13,7 +13,9 @@
  * The log output macros print output to the console. These macros produce
  * compiled log output only if the LOG_LEVEL defined in the makefile (or the
  * make command line) is greater or equal than the level required for that
- * type of log output.
+ * type of log output. Source files covered by an entry of the
+ * LOG_LEVEL_MODULES build option are built with LOG_LEVEL_MODULE defined to
+ * the level of that entry, which then replaces LOG_LEVEL for their log output.
  *
  * The format expected is the same as for printf(). For example:
  * INFO("Info %s.\n", "message")    -> INFO:    Info message.
@@ -27,14 +29,27 @@
 #define LOG_LEVEL_INFO			U(40)
 #define LOG_LEVEL_VERBOSE		U(50)
 
+#ifdef LOG_LEVEL_MODULE
+#define LOG_LEVEL_THIS_FILE		LOG_LEVEL_MODULE
+#else
+#define LOG_LEVEL_THIS_FILE		LOG_LEVEL
+#endif
+
+/* Highest log level of all the source files, set by the build system */
+#ifndef LOG_LEVEL_MAX
+#define LOG_LEVEL_MAX			LOG_LEVEL
+#endif
+
 #ifndef __ASSEMBLER__
 
 #include <cdefs.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include <drivers/console.h>
+#include <lib/cassert.h>
 
 /*
  * Define Log Markers corresponding to each log level which will
@@ -59,32 +74,67 @@
 		}					\
 	} while (false)
 
-#if LOG_LEVEL >= LOG_LEVEL_ERROR
-# define ERROR(...)	tf_log(LOG_MARKER_ERROR __VA_ARGS__)
+#if LOG_BINARY && IMAGE_BL31
+/*
+ * In binary mode, the log macros record a reference to their format string
+ * and the raw values of their arguments instead of printing them. The format
+ * strings are only kept in the .tf_log_fmt section of the ELF file, which
+ * isn't loaded, and they are referred to by their offset in that section.
+ * Arguments must fit in a register, so "%s" arguments are recorded as
+ * pointers, which the decoder can only resolve for strings in the image.
+ */
+#define TF_LOG_BIN_MAX_ARGS		12
+
+#define TF_LOG_NARGS(...)						\
+	TF_LOG_NARGS_(0, ##__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9,	\
+		      8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define TF_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10,	\
+		      _11, _12, _13, _14, _15, _16, n, ...)	n
+
+# define TF_LOG(fmt, ...)						\
+	do {								\
+		static const char tf_log_fmt[] __section(".tf_log_fmt")	\
+			__used = fmt;					\
+		static const volatile uintptr_t tf_log_id =		\
+			(uintptr_t)tf_log_fmt;				\
+		CASSERT(TF_LOG_NARGS(__VA_ARGS__) <= TF_LOG_BIN_MAX_ARGS,\
+			assert_tf_log_too_many_args);			\
+		if (false) {						\
+			tf_log(fmt, ##__VA_ARGS__);			\
+		}							\
+		tf_log_bin((unsigned int)(fmt)[0], tf_log_id,		\
+			   TF_LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__);	\
+	} while (false)
+#else
+# define TF_LOG(...)	tf_log(__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_ERROR
+# define ERROR(...)	TF_LOG(LOG_MARKER_ERROR __VA_ARGS__)
 #else
 # define ERROR(...)	no_tf_log(LOG_MARKER_ERROR __VA_ARGS__)
 #endif
 
-#if LOG_LEVEL >= LOG_LEVEL_NOTICE
-# define NOTICE(...)	tf_log(LOG_MARKER_NOTICE __VA_ARGS__)
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_NOTICE
+# define NOTICE(...)	TF_LOG(LOG_MARKER_NOTICE __VA_ARGS__)
 #else
 # define NOTICE(...)	no_tf_log(LOG_MARKER_NOTICE __VA_ARGS__)
 #endif
 
-#if LOG_LEVEL >= LOG_LEVEL_WARNING
-# define WARN(...)	tf_log(LOG_MARKER_WARNING __VA_ARGS__)
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_WARNING
+# define WARN(...)	TF_LOG(LOG_MARKER_WARNING __VA_ARGS__)
 #else
 # define WARN(...)	no_tf_log(LOG_MARKER_WARNING __VA_ARGS__)
 #endif
 
-#if LOG_LEVEL >= LOG_LEVEL_INFO
-# define INFO(...)	tf_log(LOG_MARKER_INFO __VA_ARGS__)
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_INFO
+# define INFO(...)	TF_LOG(LOG_MARKER_INFO __VA_ARGS__)
 #else
 # define INFO(...)	no_tf_log(LOG_MARKER_INFO __VA_ARGS__)
 #endif
 
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
-# define VERBOSE(...)	tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
+# define VERBOSE(...)	TF_LOG(LOG_MARKER_VERBOSE __VA_ARGS__)
 #else
 # define VERBOSE(...)	no_tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
 #endif
@@ -110,6 +160,10 @@ void __dead2 __stack_chk_fail(void);
 
 void tf_log(const char *fmt, ...) __printflike(1, 2);
 void tf_log_set_max_level(unsigned int log_level);
+#if LOG_BINARY && IMAGE_BL31
+void tf_log_bin(unsigned int log_level, uintptr_t fmt_id, unsigned int nargs,
+		...);
+#endif
 
 #endif /* __ASSEMBLER__ */
 #endif /* DEBUG_H */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TF_LOG_BIN_H
+#define TF_LOG_BIN_H
+
+#include <stdint.h>
+
+#include <cdefs.h>
+#include <lib/cassert.h>
+#include <lib/utils_def.h>
+
+#include <platform_def.h>
+
+/*
+ * Layout of the log records kept by BL31 when built with LOG_BINARY=1, which
+ * tools/tflog/tflog.py decodes from a memory dump of 'tf_log_bin_buf'.
+ *
+ * Each CPU has a ring of 64-bit words in which records are appended. A record
+ * is made of:
+ *   - a header word holding the offset of the format string in the .tf_log_fmt
+ *     section of the BL31 ELF file in bits [63:32], and the number of
+ *     arguments in bits [7:0];
+ *   - the value of the system counter when the record was made;
+ *   - the arguments, one word each.
+ * 'head' and 'tail' count words since boot, and 'tail' is always the start of
+ * the oldest record that hasn't been overwritten.
+ */
+#define TF_LOG_BIN_MAGIC		U(0x474c4654)	/* "TFLG" */
+#define TF_LOG_BIN_VERSION		U(1)
+
+#define TF_LOG_BIN_REC_HDR_WORDS	U(2)
+#define TF_LOG_BIN_REC_FMT_SHIFT	U(32)
+#define TF_LOG_BIN_REC_NARGS_MASK	U(0xff)
+
+#ifndef PLAT_LOG_BIN_RING_WORDS
+#define PLAT_LOG_BIN_RING_WORDS		U(512)
+#endif
+#define TF_LOG_BIN_RING_WORDS		PLAT_LOG_BIN_RING_WORDS
+
+CASSERT(IS_POWER_OF_TWO(TF_LOG_BIN_RING_WORDS),
+	assert_tf_log_bin_ring_words_power_of_two);
+
+typedef struct tf_log_bin_ring {
+	uint64_t head;
+	uint64_t tail;
+	uint64_t words[TF_LOG_BIN_RING_WORDS];
+} __aligned(CACHE_WRITEBACK_GRANULE) tf_log_bin_ring_t;
+
+typedef struct tf_log_bin {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t num_cpus;
+	uint32_t ring_words;
+	/* Offset of 'cpus' and size of each of its entries, in bytes */
+	uint32_t cpus_offset;
+	uint32_t ring_size;
+	tf_log_bin_ring_t cpus[PLATFORM_CORE_COUNT];
+} tf_log_bin_t;
+
+#endif /* TF_LOG_BIN_H */
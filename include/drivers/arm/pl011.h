@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -51,6 +51,9 @@
 #define PL011_UARTFR_RXFE_BIT	4	/* Receive FIFO empty bit in UARTFR register */
 #define PL011_UARTFR_BUSY_BIT	3	/* UART busy bit in UARTFR register */
 
+/* Depth of the transmit FIFO of the earliest revisions, later ones have 32 */
+#define PL011_TX_FIFO_MIN_DEPTH	16
+
 /* Control reg bits */
 #if !PL011_GENERIC_UART
 #define PL011_UARTCR_CTSEN        (1 << 15)	/* CTS hardware flow control enable */
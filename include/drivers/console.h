@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -14,8 +14,9 @@
 #define CONSOLE_T_PUTC			(U(2) * REGSZ)
 #define CONSOLE_T_GETC			(U(3) * REGSZ)
 #define CONSOLE_T_FLUSH			(U(4) * REGSZ)
-#define CONSOLE_T_BASE			(U(5) * REGSZ)
-#define CONSOLE_T_DRVDATA		(U(6) * REGSZ)
+#define CONSOLE_T_TX_SPACE		(U(5) * REGSZ)
+#define CONSOLE_T_BASE			(U(6) * REGSZ)
+#define CONSOLE_T_DRVDATA		(U(7) * REGSZ)
 
 #define CONSOLE_FLAG_BOOT		(U(1) << 0)
 #define CONSOLE_FLAG_RUNTIME		(U(1) << 1)
@@ -32,6 +33,7 @@
 
 #ifndef __ASSEMBLER__
 
+#include <stddef.h>
 #include <stdint.h>
 
 typedef struct console {
@@ -44,6 +46,11 @@ typedef struct console {
 	int (*const putc)(int character, struct console *console);
 	int (*const getc)(struct console *console);
 	void (*const flush)(struct console *console);
+	/*
+	 * Optional, returns the number of characters putc() can take without
+	 * waiting, where a '\n' counts as two.
+	 */
+	int (*const tx_space)(struct console *console);
 	uintptr_t base;
 	/* Additional private driver data may follow here. */
 } console_t;
@@ -71,12 +78,54 @@ void console_set_scope(console_t *console, unsigned int scope);
 
 /* Switch to a new global console state (CONSOLE_FLAG_BOOT/RUNTIME/CRASH). */
 void console_switch_state(unsigned int new_state);
-/* Output a character on all consoles registered for the current state. */
+/*
+ * Output a character on all consoles registered for the current state. With
+ * ASYNC_CONSOLE=1, the output of BL31 in the runtime state is buffered, see
+ * console_async_drain().
+ */
 int console_putc(int c);
+/* Output a character on all consoles registered for the current state, now. */
+int console_putc_sync(int c);
+/*
+ * Output 'len' characters on all consoles registered for the current state,
+ * walking the list of consoles once rather than once per character. Returns 0,
+ * or the error of a console which failed.
+ */
+int console_write(const char *buf, size_t len);
 /* Read a character (blocking) from any console registered for current state. */
 int console_getc(void);
 /* Flush all consoles registered for the current state. */
 void console_flush(void);
+/*
+ * Return the number of characters, where a '\n' counts as two, that all the
+ * consoles registered for the current state can take without waiting. 0 if any
+ * of them doesn't implement tx_space().
+ */
+int console_tx_space(void);
+
+#if ASYNC_CONSOLE && IMAGE_BL31
+/* Buffer a character written by console_putc() in the runtime state. */
+int console_async_putc(int c);
+/* Write the characters buffered by all the CPUs to the consoles. */
+void console_async_drain(void);
+/* Same, but write at most PLAT_CONSOLE_DRAIN_BUDGET characters. */
+void console_async_drain_bounded(void);
+/*
+ * Write at most PLAT_CONSOLE_DRAIN_BUDGET characters of the calling CPU, and
+ * only as many as the consoles can take without waiting.
+ */
+void console_async_drain_local(void);
+#else
+static inline void console_async_drain(void)
+{
+}
+static inline void console_async_drain_bounded(void)
+{
+}
+static inline void console_async_drain_local(void)
+{
+}
+#endif
 
 #endif /* __ASSEMBLER__ */
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -23,6 +23,10 @@ CASSERT(CONSOLE_T_GETC == __builtin_offsetof(console_t, getc),
 	assert_console_t_getc_offset_mismatch);
 CASSERT(CONSOLE_T_FLUSH == __builtin_offsetof(console_t, flush),
 	assert_console_t_flush_offset_mismatch);
+CASSERT(CONSOLE_T_TX_SPACE == __builtin_offsetof(console_t, tx_space),
+	assert_console_t_tx_space_offset_mismatch);
+CASSERT(CONSOLE_T_BASE == __builtin_offsetof(console_t, base),
+	assert_console_t_base_offset_mismatch);
 CASSERT(CONSOLE_T_DRVDATA == sizeof(console_t),
 	assert_console_t_drvdata_offset_mismatch);
 
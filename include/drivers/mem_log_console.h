@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MEM_LOG_CONSOLE_H
+#define MEM_LOG_CONSOLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <drivers/console.h>
+
+/*
+ * The memory log console keeps the console output in a region of memory that
+ * the Non-secure world can read, for example to collect the firmware logs
+ * without a serial line. The region starts with a mem_log_hdr_t, followed by
+ * 'num_cpus' rings of 'ring_size' bytes, each made of a mem_log_ring_t and of
+ * the text written by one CPU. 'head' counts the bytes ever written to the
+ * ring, so the text is the last min(head, ring_size - sizeof(mem_log_ring_t))
+ * bytes, ending at offset head modulo that size. Only the owning CPU writes to
+ * a ring, so no lock is needed.
+ *
+ * The region is kept as is when BL31 restarts and finds a header matching its
+ * configuration, so that the logs survive a warm reset.
+ */
+#define MEM_LOG_MAGIC		U(0x4d4c4654)	/* "TFLM" */
+#define MEM_LOG_VERSION		U(1)
+
+/*
+ * Compatible string of the devicetree node describing the region, so that the
+ * OS can find it. The node has a "reg" property giving the whole region, which
+ * is laid out as described above.
+ */
+#define MEM_LOG_DT_COMPATIBLE	"arm,tf-a-mem-log"
+
+typedef struct mem_log_hdr {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t num_cpus;
+	uint32_t ring_size;
+	/* Number of times BL31 has started since the region was set up */
+	uint32_t boot_count;
+	uint32_t reserved[3];
+} mem_log_hdr_t;
+
+typedef struct mem_log_ring {
+	volatile uint64_t head;
+	uint64_t reserved;
+} mem_log_ring_t;
+
+typedef struct {
+	console_t console;
+	size_t ring_size;
+} console_mem_log_t;
+
+/*
+ * Register a memory log console on the region of 'size' bytes at 'base',
+ * which must be mapped as Non-cacheable memory so that the text is visible
+ * without any cache maintenance. Returns 1 on success, 0 if the region is too
+ * small.
+ */
+int console_mem_log_register(uintptr_t base, size_t size,
+			     console_mem_log_t *console);
+
+#endif /* MEM_LOG_CONSOLE_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -63,7 +63,8 @@
 #define UARTLSR_TXFIFOFULL	(1 << 8)	/* Tx Fifo Full */
 #define UARTLSR_RXFIFOERR	(1 << 7)	/* Rx Fifo Error */
 #define UARTLSR_TEMT		(1 << 6)	/* Tx Shift Register Empty */
-#define UARTLSR_THRE		(1 << 5)	/* Tx Holding Register Empty */
+#define UARTLSR_THRE_BIT	(5)		/* Tx Holding Register Empty Bit */
+#define UARTLSR_THRE		(1 << UARTLSR_THRE_BIT)	/* Tx Holding Register Empty */
 #define UARTLSR_BRK		(1 << 4)	/* Break Condition Detected */
 #define UARTLSR_FERR		(1 << 3)	/* Framing Error */
 #define UARTLSR_PERR		(1 << 3)	/* Parity Error */
@@ -71,10 +72,22 @@
 #define UARTLSR_RDR_BIT		(0)		/* Rx Data Ready Bit */
 #define UARTLSR_RDR		(1 << UARTLSR_RDR_BIT)	/* Rx Data Ready */
 
+/* Offsets of the fields of console_16550_t */
+#define CONSOLE_T_16550_FIFO_SIZE	CONSOLE_T_DRVDATA
+#define CONSOLE_T_16550_TX_FREE		(CONSOLE_T_DRVDATA + 4)
+
 #ifndef __ASSEMBLER__
 
 #include <stdint.h>
 
+typedef struct {
+	console_t console;
+	/* Depth of the transmit FIFO */
+	uint32_t fifo_size;
+	/* Characters the transmit FIFO can take without polling the UART */
+	uint32_t tx_free;
+} console_16550_t;
+
 /*
  * Initialize a new 16550 console instance and register it with the console
  * framework. The |console| pointer must point to storage that will be valid
@@ -89,6 +102,18 @@
 int console_16550_register(uintptr_t baseaddr, uint32_t clock, uint32_t baud,
 			   console_t *console);
 
+/*
+ * Same as console_16550_register(), but the console fills the transmit FIFO of
+ * |fifo_size| characters in bursts: once the FIFO is seen empty, that many
+ * characters are written to it without reading the line status in between.
+ * As the space left in the FIFO is only tracked by the console, the UART must
+ * not be written by anything else while this console is in use, including by
+ * other CPUs printing at the same time. Only available in AArch64.
+ */
+int console_16550_fifo_register(uintptr_t baseaddr, uint32_t clock,
+				uint32_t baud, uint32_t fifo_size,
+				console_16550_t *console);
+
 #endif /*__ASSEMBLER__*/
 
 #endif /* UART_16550_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2019-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -56,6 +56,8 @@ enum bl_aux_param_type {
 	BL_AUX_PARAM_VENDOR_SPECIFIC_LAST = 0x7fffffff,
 	BL_AUX_PARAM_GENERIC_FIRST = 0x80000001,
 	BL_AUX_PARAM_COREBOOT_TABLE = BL_AUX_PARAM_GENERIC_FIRST,
+	/* bl_aux_param_uint64 holding the address of a boot_prof_t */
+	BL_AUX_PARAM_BOOT_PROF,
 	/* 0x80000001 - 0xffffffff are reserved for the generic handler. */
 	BL_AUX_PARAM_GENERIC_LAST = 0xffffffff,
 	/* Top 32 bits of the type field are reserved for future use. */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,6 +16,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include <lib/spinlock.h>
 #include <lib/utils_def.h>
 
 /*****************************************************************************
@@ -51,7 +52,14 @@ static inline uint16_t make_bakery_data(unsigned int choosing, unsigned int num)
 /*****************************************************************************
  * External bakery lock interface.
  ****************************************************************************/
-#if USE_COHERENT_MEM
+#if USE_ATOMIC_BAKERY_LOCKS
+/*
+ * All contenders are coherent and have their data cache enabled whenever they
+ * hold a bakery lock, so a single ticket lock in normal memory is enough.
+ */
+typedef ticketlock_t bakery_lock_t;
+
+#elif USE_COHERENT_MEM
 /*
  * Bakery locks are stored in coherent memory
  *
@@ -90,13 +98,25 @@ typedef struct bakery_info {
 
 typedef bakery_info_t bakery_lock_t;
 
-#endif /* __USE_COHERENT_MEM__ */
+#endif /* USE_ATOMIC_BAKERY_LOCKS */
 
 static inline void bakery_lock_init(bakery_lock_t *bakery) {}
 void bakery_lock_get(bakery_lock_t *bakery);
 void bakery_lock_release(bakery_lock_t *bakery);
 
+#if ENABLE_LOCK_PROFILING && !USE_ATOMIC_BAKERY_LOCKS
+/*
+ * Tell whether another CPU holds the lock or is trying to take it. This is
+ * only a snapshot, used by the lock profiler.
+ */
+bool bakery_lock_is_contended(bakery_lock_t *bakery);
+#endif
+
+#if USE_ATOMIC_BAKERY_LOCKS
+#define DEFINE_BAKERY_LOCK(_name) bakery_lock_t _name
+#else
 #define DEFINE_BAKERY_LOCK(_name) bakery_lock_t _name __section("bakery_lock")
+#endif
 
 #define DECLARE_BAKERY_LOCK(_name) extern bakery_lock_t _name
 
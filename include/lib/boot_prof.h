@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BOOT_PROF_H
+#define BOOT_PROF_H
+
+#include <lib/utils_def.h>
+
+#include <platform_def.h>
+
+/*
+ * Boot profiler, enabled with BOOT_PROFILING=1.
+ *
+ * Each boot stage records the beginning and the end of the steps of the cold
+ * boot below, with the value of the system counter, in a boot_prof_t of its
+ * own. BL1 and BL2 pass their records to the next image in a
+ * BL_AUX_PARAM_BOOT_PROF aux parameter, whose address is put in arg4 of its
+ * entry point information with BOOT_PROF_HANDOFF_TAG in arg5, unless the
+ * platform uses either of them. The entrypoint of BL2 and BL31 only reads the
+ * parameter when x5 holds the tag, as other loaders leave x4 undefined, and
+ * copies the records before zeroing its NOBITS sections, which may overlap
+ * them. The records are then imported, so that BL31 ends up with those of the
+ * whole boot, which it prints at the end of the cold boot for
+ * tools/bootprof/bootprof.py to render as a timeline. Platforms which pass an
+ * aux parameter list of their own can add boot_prof_aux_param() to it instead.
+ */
+#define BOOT_PROF_MAGIC			U(0x46505442)	/* "BTPF" */
+#define BOOT_PROF_VERSION		U(1)
+
+/* Steps recorded, the argument is the image ID where one is given */
+#define BOOT_PROF_STAGE			U(1)
+#define BOOT_PROF_EARLY_PLAT_SETUP	U(2)
+#define BOOT_PROF_PLAT_ARCH_SETUP	U(3)
+#define BOOT_PROF_PLAT_SETUP		U(4)
+#define BOOT_PROF_LOAD_IMAGE		U(5)	/* image ID */
+#define BOOT_PROF_IO_READ		U(6)	/* image ID */
+#define BOOT_PROF_AUTH			U(7)	/* image ID */
+#define BOOT_PROF_HASH			U(8)
+#define BOOT_PROF_SIG_VERIFY		U(9)
+#define BOOT_PROF_DECOMPRESS		U(10)
+#define BOOT_PROF_RUNTIME_SVC_INIT	U(11)
+#define BOOT_PROF_BL32_INIT		U(12)
+
+#ifndef PLAT_BOOT_PROF_MAX_RECORDS
+#define PLAT_BOOT_PROF_MAX_RECORDS	U(128)
+#endif
+
+/* Size of boot_prof_t, for the entrypoints */
+#define BOOT_PROF_SIZE			(U(16) + \
+					 (U(16) * PLAT_BOOT_PROF_MAX_RECORDS))
+
+/* Handoff in arg4 and arg5, see above. "BOOTPROF" in x5 */
+#define BOOT_PROF_HANDOFF_TAG		ULL(0x464f5250544f4f42)
+/* BL_AUX_PARAM_BOOT_PROF and the offset of its value, for the entrypoints */
+#define BOOT_PROF_AUX_PARAM_TYPE	U(0x80000002)
+#define BOOT_PROF_AUX_PARAM_VALUE	U(16)
+
+#ifndef __ASSEMBLER__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct bl_aux_param_header;
+struct entry_point_info;
+
+typedef struct boot_prof_rec {
+	/* Value of the system counter */
+	uint64_t timestamp;
+	uint32_t arg;
+	uint8_t step;
+	/* Number of the boot stage, 1, 2, 31 or 32 */
+	uint8_t stage;
+	/* 0 at the beginning of the step, 1 at its end */
+	uint8_t end;
+	uint8_t reserved;
+} boot_prof_rec_t;
+
+typedef struct boot_prof {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t num_records;
+	/* Records which didn't fit */
+	uint32_t dropped;
+	boot_prof_rec_t records[PLAT_BOOT_PROF_MAX_RECORDS];
+} boot_prof_t;
+
+#if BOOT_PROFILING
+
+void boot_prof_record(unsigned int step, unsigned int arg, bool end);
+/* Return the records of this stage, for example to pass them to the next */
+const boot_prof_t *boot_prof_get(void);
+/* Add the records of the previous stages to those of this stage */
+void boot_prof_import(const boot_prof_t *prev);
+/* Import the records copied by the entrypoint of this stage */
+void boot_prof_import_prev(void);
+/* Return an aux parameter holding the records of this stage */
+struct bl_aux_param_header *boot_prof_aux_param(void);
+/* Pass the records of this stage to the next image, if its args allow */
+void boot_prof_handoff(struct entry_point_info *next_ep_info);
+void boot_prof_print(void);
+
+#define BOOT_PROF_BEGIN(step, arg)	boot_prof_record((step), (arg), false)
+#define BOOT_PROF_END(step, arg)	boot_prof_record((step), (arg), true)
+
+#else
+
+#define BOOT_PROF_BEGIN(step, arg)
+#define BOOT_PROF_END(step, arg)
+
+static inline void boot_prof_import_prev(void)
+{
+}
+
+static inline struct bl_aux_param_header *boot_prof_aux_param(void)
+{
+	return NULL;
+}
+
+static inline void boot_prof_handoff(struct entry_point_info *next_ep_info)
+{
+}
+
+static inline void boot_prof_print(void)
+{
+}
+
+#endif /* BOOT_PROFILING */
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* BOOT_PROF_H */
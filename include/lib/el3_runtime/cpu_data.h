@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -35,7 +35,7 @@
 
 #else	/* !__aarch64__ */
 
-#if CRASH_REPORTING
+#if CRASH_REPORTING || CRASH_DUMP_MEM
 #error "Crash reporting is not supported in AArch32"
 #endif
 #define CPU_DATA_CPU_OPS_PTR		0x0
@@ -43,7 +43,7 @@
 
 #endif	/* __aarch64__ */
 
-#if CRASH_REPORTING
+#if CRASH_REPORTING || CRASH_DUMP_MEM
 #define CPU_DATA_CRASH_BUF_END		(CPU_DATA_CRASH_BUF_OFFSET + \
 						CPU_DATA_CRASH_BUF_SIZE)
 #else
@@ -106,7 +106,7 @@ typedef struct cpu_data {
 #if ENABLE_PAUTH
 	uint64_t apiakey[2];
 #endif
-#if CRASH_REPORTING
+#if CRASH_REPORTING || CRASH_DUMP_MEM
 	u_register_t crash_buf[CPU_DATA_CRASH_BUF_SIZE >> 3];
 #endif
 #if ENABLE_RUNTIME_INSTRUMENTATION
@@ -128,7 +128,7 @@ CASSERT(CPU_DATA_APIAKEY_OFFSET == __builtin_offsetof
 	assert_cpu_data_crash_stack_offset_mismatch);
 #endif
 
-#if CRASH_REPORTING
+#if CRASH_REPORTING || CRASH_DUMP_MEM
 /* verify assembler offsets match data structures */
 CASSERT(CPU_DATA_CRASH_BUF_OFFSET == __builtin_offsetof
 	(cpu_data_t, crash_buf),
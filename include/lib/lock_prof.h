@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef LOCK_PROF_H
+#define LOCK_PROF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <lib/cassert.h>
+#include <lib/utils_def.h>
+#include <services/ven_el3_svc.h>
+
+#if NS_SHARED_BUF_SUPPORT
+#define LOCK_PROF_NUM_SMC_CALLS		U(2)
+#else
+#define LOCK_PROF_NUM_SMC_CALLS		U(1)
+#endif
+
+/* Number of lock call sites that are tracked for each CPU */
+#ifndef PLAT_LOCK_PROF_MAX_SITES
+#define PLAT_LOCK_PROF_MAX_SITES	U(32)
+#endif
+
+/* Value of lock_prof_site_t.last_holder when the holder isn't known */
+#define LOCK_PROF_NO_HOLDER		U(0xffffffff)
+
+/* Lock profiling error numbers */
+#define LOCK_PROF_E_SUCCESS		0
+#define LOCK_PROF_E_INVALID_PARAMS	-2
+#define LOCK_PROF_E_DENIED		-3
+
+/*
+ * Contention statistics of one lock call site, as seen by one CPU. Wait times
+ * are measured in system counter ticks, from the call to the lock function to
+ * the acquisition of the lock. This structure is also what the
+ * VEN_EL3_LOCK_PROF_GET call copies to the Non-secure shared buffer.
+ */
+typedef struct lock_prof_site {
+	uint64_t site;			/* Return address of the lock call */
+	uint64_t lock;			/* Last lock taken from this site */
+	uint32_t acquires;		/* Number of acquisitions */
+	uint32_t contended;		/* Acquisitions which had to wait */
+	uint64_t wait_ticks;		/* Total time spent waiting */
+	uint64_t max_wait_ticks;	/* Longest single wait */
+	uint32_t last_holder;		/* Holder at the last contended wait */
+	uint32_t reserved;
+} lock_prof_site_t;
+
+CASSERT(sizeof(lock_prof_site_t) == 48U, assert_lock_prof_site_size);
+
+#if ENABLE_LOCK_PROFILING
+static inline bool is_lock_prof_fid(uint32_t smc_fid)
+{
+#if NS_SHARED_BUF_SUPPORT
+	if (smc_fid == VEN_EL3_LOCK_PROF_GET) {
+		return true;
+	}
+#endif
+	return smc_fid == VEN_EL3_LOCK_PROF_PRINT;
+}
+#else
+static inline bool is_lock_prof_fid(uint32_t smc_fid)
+{
+	return false;
+}
+#endif
+
+/* Print the statistics of all the CPUs on the console */
+void lock_prof_print(void);
+
+uintptr_t lock_prof_smc_handler(uint32_t smc_fid,
+				u_register_t x1,
+				u_register_t x2,
+				u_register_t x3,
+				u_register_t x4,
+				void *cookie,
+				void *handle,
+				u_register_t flags);
+
+#endif /* LOCK_PROF_H */
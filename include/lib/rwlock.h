@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+/*
+ * The lock word holds the number of readers in bits [30:0] and is set to
+ * RWLOCK_WRITER while a writer holds the lock.
+ */
+#define RWLOCK_WRITER_SHIFT	31
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+/*
+ * Reader-writer spinlock. Any number of readers may hold the lock at the same
+ * time, while a writer excludes both readers and other writers. Readers are
+ * favoured: a writer waits until there are no readers left, so this should
+ * only protect data which is rarely written.
+ *
+ * As with spinlocks, the lock relies on exclusive access instructions and can
+ * only be used once the MMU and data cache are enabled.
+ */
+typedef struct rwlock {
+	volatile uint32_t lock;
+} rwlock_t;
+
+void read_lock(rwlock_t *lock);
+void read_unlock(rwlock_t *lock);
+void write_lock(rwlock_t *lock);
+void write_unlock(rwlock_t *lock);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* RWLOCK_H */
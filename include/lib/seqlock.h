@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <lib/spinlock.h>
+
+/*
+ * Sequence count, for data which is read much more often than it is written
+ * and whose writers are already serialised, e.g. because only one CPU ever
+ * updates it or because the caller holds another lock.
+ *
+ * Writers make the sequence count odd for the duration of their update.
+ * Readers never write to the count: they sample it, copy the data, and start
+ * again if a writer was active or has completed in the meantime. Readers must
+ * therefore only copy the protected data, without acting on it, before
+ * read_seqcount_retry() succeeds.
+ *
+ * Both sides only rely on plain loads, stores and barriers, so they may be
+ * used with the MMU off.
+ */
+typedef struct seqcount {
+	volatile uint32_t seq;
+} seqcount_t;
+
+static inline void seqcount_read_barrier(void)
+{
+#ifdef __aarch64__
+	dmbishld();
+#else
+	dmbish();
+#endif
+}
+
+static inline uint32_t read_seqcount_begin(const seqcount_t *sc)
+{
+	uint32_t seq;
+
+	do {
+		seq = sc->seq;
+	} while ((seq & 1U) != 0U);
+
+	/* Order the read of the sequence count before the reads of the data */
+	seqcount_read_barrier();
+
+	return seq;
+}
+
+static inline bool read_seqcount_retry(const seqcount_t *sc, uint32_t seq)
+{
+	/* Order the reads of the data before the check of the sequence count */
+	seqcount_read_barrier();
+
+	return sc->seq != seq;
+}
+
+static inline void write_seqcount_begin(seqcount_t *sc)
+{
+	sc->seq++;
+	/* Make the odd count visible before any of the updates */
+	dmbishst();
+}
+
+static inline void write_seqcount_end(seqcount_t *sc)
+{
+	/* Make the updates visible before the count becomes even again */
+	dmbishst();
+	sc->seq++;
+}
+
+/*
+ * Sequence lock, a sequence count whose writers are serialised by a spinlock.
+ * The write side requires the MMU and data cache to be enabled unless a single
+ * CPU is running.
+ */
+typedef struct seqlock {
+	spinlock_t lock;
+	seqcount_t sc;
+} seqlock_t;
+
+static inline uint32_t read_seqbegin(const seqlock_t *sl)
+{
+	return read_seqcount_begin(&sl->sc);
+}
+
+static inline bool read_seqretry(const seqlock_t *sl, uint32_t seq)
+{
+	return read_seqcount_retry(&sl->sc, seq);
+}
+
+static inline void write_seqlock(seqlock_t *sl)
+{
+	spin_lock(&sl->lock);
+	write_seqcount_begin(&sl->sc);
+}
+
+static inline void write_sequnlock(seqlock_t *sl)
+{
+	write_seqcount_end(&sl->sc);
+	spin_unlock(&sl->lock);
+}
+
+#endif /* SEQLOCK_H */
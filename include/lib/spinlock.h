@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,10 +7,25 @@
 #ifndef SPINLOCK_H
 #define SPINLOCK_H
 
+/*
+ * Ticket lock layout. The lock word holds the ticket of the current owner in
+ * its low half and the next ticket to hand out in its high half.
+ */
+#define TICKETLOCK_OWNER_SHIFT		0
+#define TICKETLOCK_NEXT_SHIFT		16
+
+#if TICKET_LOCK_STATS
+#define TICKETLOCK_ACQUIRES		8
+#define TICKETLOCK_CONTENDED_TICKS	16
+#endif
+
 #ifndef __ASSEMBLER__
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <lib/cassert.h>
+
 typedef struct spinlock {
 	volatile uint32_t lock;
 } spinlock_t;
@@ -18,6 +33,32 @@ typedef struct spinlock {
 void spin_lock(spinlock_t *lock);
 void spin_unlock(spinlock_t *lock);
 
+/*
+ * A ticket lock hands the lock over to the waiters in the order in which they
+ * arrived, and each waiter only reads the lock word until its turn comes.
+ * Prefer it to a spinlock for locks which are taken by many CPUs at once.
+ */
+typedef struct ticketlock {
+	volatile uint32_t lock;
+#if TICKET_LOCK_STATS
+	uint32_t reserved;
+	/* Number of times the lock was acquired */
+	uint64_t acquires;
+	/* System counter ticks spent waiting for the lock by all CPUs */
+	uint64_t contended_ticks;
+#endif
+} ticketlock_t;
+
+#if TICKET_LOCK_STATS
+CASSERT(TICKETLOCK_ACQUIRES == offsetof(ticketlock_t, acquires),
+	assert_ticketlock_acquires_offset_mismatch);
+CASSERT(TICKETLOCK_CONTENDED_TICKS == offsetof(ticketlock_t, contended_ticks),
+	assert_ticketlock_contended_ticks_offset_mismatch);
+#endif
+
+void ticket_lock(ticketlock_t *lock);
+void ticket_unlock(ticketlock_t *lock);
+
 #else
 
 /* Spin lock definitions for use in assembly */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -108,6 +108,17 @@
 #define XLAT_BLOCK_MASK(level)	(XLAT_BLOCK_SIZE(level) - UL(1))
 /* Mask to get the address bits common to a block of a certain table level*/
 #define XLAT_ADDR_MASK(level)	(~XLAT_BLOCK_MASK(level))
+
+/*
+ * Number of adjacent block or page descriptors that the MMU can cache in a
+ * single TLB entry when their Contiguous hint is set. With the 4KB granule it
+ * is 16 at all lookup levels.
+ */
+#define XLAT_CONT_ENTRIES_SHIFT	U(4)
+#define XLAT_CONT_ENTRIES	(U(1) << XLAT_CONT_ENTRIES_SHIFT)
+#define XLAT_CONT_SIZE(level)	\
+	(ULL(1) << (XLAT_ADDR_SHIFT(level) + XLAT_CONT_ENTRIES_SHIFT))
+#define XLAT_CONT_MASK(level)	(XLAT_CONT_SIZE(level) - ULL(1))
 /*
  * Extract from the given virtual address the index into the given lookup level.
  * This macro assumes the system is using the 4KB translation granule.
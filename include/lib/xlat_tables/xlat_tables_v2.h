@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -398,5 +398,25 @@ int xlat_get_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 				uint32_t *attr);
 int xlat_get_mem_attributes(uintptr_t base_va, uint32_t *attr);
 
+/*
+ * Query the usage of the translation tables of a context, excluding its base
+ * table. This lets code that maps and unmaps dynamic regions at runtime check
+ * how close it is to running out of tables.
+ *
+ * ctx
+ *   Translation context to work on.
+ * used
+ *   Output parameter where to store the number of tables currently in use.
+ * max_used
+ *   Output parameter where to store the maximum number of tables that have
+ *   been in use at the same time.
+ * total
+ *   Output parameter where to store the number of tables of the context.
+ */
+void xlat_get_tables_usage_ctx(const xlat_ctx_t *ctx, unsigned int *used,
+			       unsigned int *max_used, unsigned int *total);
+void xlat_get_tables_usage(unsigned int *used, unsigned int *max_used,
+			   unsigned int *total);
+
 #endif /*__ASSEMBLER__*/
 #endif /* XLAT_TABLES_V2_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -80,10 +80,28 @@ struct xlat_ctx {
 	 */
 #if PLAT_XLAT_TABLES_DYNAMIC
 	int *tables_mapped_regions;
+
+	/*
+	 * List of the tables that have been used and released since. Tables
+	 * are linked through their first entry.
+	 */
+	uint64_t *free_tables;
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
+	/*
+	 * Number of tables that have ever been allocated. Tables at and above
+	 * this index have never been used.
+	 */
 	int next_table;
 
+	/*
+	 * Last translation table below the base level in which a lookup ended,
+	 * used to skip the upper levels of the walk for the following lookups
+	 * in the same table. It is kept outside of the context so that lookups
+	 * can update it through a const context. NULL if not used.
+	 */
+	uintptr_t *lookup_cache;
+
 	/*
 	 * Base translation table. It doesn't need to have the same amount of
 	 * entries as the ones used for other levels.
@@ -117,7 +135,8 @@ struct xlat_ctx {
 	static int _ctx_name##_mapped_regions[_xlat_tables_count];
 
 #define XLAT_REGISTER_DYNMAP_STRUCT(_ctx_name)				\
-	.tables_mapped_regions = _ctx_name##_mapped_regions,
+	.tables_mapped_regions = _ctx_name##_mapped_regions,		\
+	.free_tables = NULL,
 #else
 #define XLAT_ALLOC_DYNMAP_STRUCT(_ctx_name, _xlat_tables_count)		\
 	/* do nothing */
@@ -155,6 +174,8 @@ struct xlat_ctx {
 									\
 	XLAT_ALLOC_DYNMAP_STRUCT(_ctx_name, _xlat_tables_count)		\
 									\
+	static uintptr_t _ctx_name##_lookup_cache;			\
+									\
 	static xlat_ctx_t _ctx_name##_xlat_ctx = {			\
 		.pa_max_address = (_phy_addr_space_size) - 1ULL,	\
 		.va_max_address = (_virt_addr_space_size) - 1UL,	\
@@ -165,6 +186,7 @@ struct xlat_ctx {
 		 XLAT_CTX_INIT_TABLE_ATTR()				\
 		 XLAT_REGISTER_DYNMAP_STRUCT(_ctx_name)			\
 		.next_table = 0,					\
+		.lookup_cache = &_ctx_name##_lookup_cache,		\
 		.base_table = _ctx_name##_base_xlat_table,		\
 		.base_table_entries =					\
 			ARRAY_SIZE(_ctx_name##_base_xlat_table),	\
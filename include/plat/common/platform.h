@@ -7,6 +7,7 @@
 #ifndef PLATFORM_H
 #define PLATFORM_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <lib/psci/psci.h>
@@ -273,6 +274,16 @@ plat_local_state_t plat_get_target_pwr_state(unsigned int lvl,
  ******************************************************************************/
 void bl31_plat_enable_mmu(uint32_t flags);
 
+/*******************************************************************************
+ * Mandatory BL31 functions when NS_SHARED_BUF_SUPPORT=1
+ ******************************************************************************/
+int plat_ns_buf_validate(unsigned long long pa, size_t size);
+
+/*******************************************************************************
+ * Optional BL31 functions when SMC_MULTICALL_SUPPORT=1 (may be overridden)
+ ******************************************************************************/
+bool plat_multicall_fid_allowed(uint32_t smc_fid);
+
 /*******************************************************************************
  * Optional BL32 functions (may be overridden)
  ******************************************************************************/
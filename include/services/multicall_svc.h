@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MULTICALL_SVC_H
+#define MULTICALL_SVC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <lib/cassert.h>
+#include <lib/utils_def.h>
+#include <services/ven_el3_svc.h>
+
+#define MULTICALL_NUM_SMC_CALLS		U(1)
+
+/* Maximum number of calls that may be batched in a single multicall */
+#ifndef PLAT_MULTICALL_MAX_CALLS
+#define PLAT_MULTICALL_MAX_CALLS	U(64)
+#endif
+
+/* Multicall Error Numbers */
+#define MULTICALL_E_SUCCESS		0
+#define MULTICALL_E_NOT_SUPPORTED	-1
+#define MULTICALL_E_INVALID_PARAMS	-2
+#define MULTICALL_E_DENIED		-3
+
+/*
+ * One call in a multicall batch, stored in the per-CPU Non-secure shared
+ * buffer. On entry, regs[0] holds the function ID and regs[1-7] hold the
+ * arguments in x1-x7. On return, regs[0-7] hold the values of x0-x7 as left
+ * by the handler of that function.
+ */
+typedef struct multicall_entry {
+	uint64_t regs[8];
+} multicall_entry_t;
+
+CASSERT(sizeof(multicall_entry_t) == 64U, assert_multicall_entry_size);
+
+#if SMC_MULTICALL_SUPPORT
+static inline bool is_multicall_fid(uint32_t smc_fid)
+{
+	return smc_fid == VEN_EL3_MULTICALL;
+}
+#else
+static inline bool is_multicall_fid(uint32_t smc_fid)
+{
+	return false;
+}
+#endif
+
+uintptr_t multicall_smc_handler(uint32_t smc_fid,
+				u_register_t x1,
+				u_register_t x2,
+				u_register_t x3,
+				u_register_t x4,
+				void *cookie,
+				void *handle,
+				u_register_t flags);
+
+#endif /* MULTICALL_SVC_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,7 +7,7 @@
 #ifndef SDEI_H
 #define SDEI_H
 
-#include <lib/spinlock.h>
+#include <lib/rwlock.h>
 #include <lib/utils_def.h>
 #include <services/sdei_flags.h>
 
@@ -114,7 +114,7 @@ typedef struct sdei_ev_map {
 	unsigned int intr;	/* Physical interrupt number for a bound map */
 	unsigned int map_flags;	/* Mapping flags, see SDEI_MAPF_* */
 	int reg_count;		/* Registration count */
-	spinlock_t lock;	/* Per-event lock */
+	rwlock_t lock;		/* Per-event lock */
 } sdei_ev_map_t;
 
 typedef struct sdei_mapping {
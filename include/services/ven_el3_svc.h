@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef VEN_EL3_SVC_H
+#define VEN_EL3_SVC_H
+
+#include <lib/utils_def.h>
+
+/* SMC function IDs for Vendor-Specific EL3 Monitor Service queries */
+#define VEN_EL3_SVC_CALL_COUNT		U(0x8700ff00)
+#define VEN_EL3_SVC_UID			U(0x8700ff01)
+/*					U(0x8700ff02) is reserved */
+#define VEN_EL3_SVC_VERSION		U(0x8700ff03)
+
+/* Vendor-Specific EL3 Monitor Service Calls version numbers */
+#define VEN_EL3_SVC_VERSION_MAJOR	U(0x0)
+#define VEN_EL3_SVC_VERSION_MINOR	U(0x1)
+
+/* Per-CPU non-secure shared buffer management */
+#define VEN_EL3_NS_BUF_REGISTER		U(0xc7000000)
+#define VEN_EL3_NS_BUF_UNREGISTER	U(0x87000001)
+#define VEN_EL3_NS_BUF_INFO		U(0x87000002)
+
+/* Batched dispatch of fast SMCs through the Non-secure shared buffer */
+#define VEN_EL3_MULTICALL		U(0xc7000010)
+
+/* Lock contention statistics */
+#define VEN_EL3_LOCK_PROF_GET		U(0xc7000020)
+#define VEN_EL3_LOCK_PROF_PRINT		U(0x87000021)
+
+#endif /* VEN_EL3_SVC_H */
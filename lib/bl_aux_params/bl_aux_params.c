@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2019-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <common/debug.h>
+#include <lib/boot_prof.h>
 #include <lib/coreboot.h>
 #include <lib/bl_aux_params/bl_aux_params.h>
 
@@ -23,6 +24,12 @@ void bl_aux_params_parse(u_register_t head,
 			coreboot_table_setup((void *)(uintptr_t)
 				((struct bl_aux_param_uint64 *)p)->value);
 			break;
+#endif
+#if BOOT_PROFILING
+		case BL_AUX_PARAM_BOOT_PROF:
+			boot_prof_import((const boot_prof_t *)(uintptr_t)
+				((struct bl_aux_param_uint64 *)p)->value);
+			break;
 #endif
 		default:
 			ERROR("Ignoring unknown BL aux parameter: 0x%llx",
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include <arch_helpers.h>
+#include <common/bl_common.h>
+#include <common/debug.h>
+#include <lib/bl_aux_params/bl_aux_params.h>
+#include <lib/boot_prof.h>
+#include <lib/cassert.h>
+
+#if IMAGE_BL1
+#define BOOT_PROF_THIS_STAGE	U(1)
+#elif IMAGE_BL2
+#define BOOT_PROF_THIS_STAGE	U(2)
+#elif IMAGE_BL31
+#define BOOT_PROF_THIS_STAGE	U(31)
+#elif IMAGE_BL32
+#define BOOT_PROF_THIS_STAGE	U(32)
+#else
+#define BOOT_PROF_THIS_STAGE	U(0)
+#endif
+
+/*
+ * Records of this stage. The header is filled in on first use so that the
+ * buffer stays in .bss, which is cleared before the first record is made.
+ */
+static boot_prof_t boot_prof __aligned(16);
+
+CASSERT(sizeof(boot_prof_t) == BOOT_PROF_SIZE, assert_boot_prof_size_mismatch);
+CASSERT(BL_AUX_PARAM_BOOT_PROF == BOOT_PROF_AUX_PARAM_TYPE,
+	assert_boot_prof_aux_param_type_mismatch);
+CASSERT(offsetof(struct bl_aux_param_uint64, value) ==
+	BOOT_PROF_AUX_PARAM_VALUE, assert_boot_prof_aux_param_value_mismatch);
+
+/* Aux parameter passing the records to the next image */
+static struct bl_aux_param_uint64 boot_prof_param;
+
+#if (IMAGE_BL2 && !BL2_AT_EL3) || (IMAGE_BL31 && !RESET_TO_BL31)
+/*
+ * Copy of the records of the previous images made by the entrypoint, in .data
+ * so that it isn't zeroed with the NOBITS sections.
+ */
+boot_prof_t boot_prof_prev __aligned(16) __section(".data.boot_prof_prev");
+#endif
+
+static boot_prof_rec_t *boot_prof_alloc(void)
+{
+	if (boot_prof.magic != BOOT_PROF_MAGIC) {
+		boot_prof.version = BOOT_PROF_VERSION;
+		boot_prof.magic = BOOT_PROF_MAGIC;
+	}
+
+	if (boot_prof.num_records == PLAT_BOOT_PROF_MAX_RECORDS) {
+		boot_prof.dropped++;
+		return NULL;
+	}
+
+	return &boot_prof.records[boot_prof.num_records++];
+}
+
+void boot_prof_record(unsigned int step, unsigned int arg, bool end)
+{
+	boot_prof_rec_t *rec = boot_prof_alloc();
+
+	if (rec != NULL) {
+		rec->timestamp = read_cntpct_el0();
+		rec->arg = (uint32_t)arg;
+		rec->step = (uint8_t)step;
+		rec->stage = (uint8_t)BOOT_PROF_THIS_STAGE;
+		rec->end = end ? 1U : 0U;
+	}
+}
+
+const boot_prof_t *boot_prof_get(void)
+{
+	return &boot_prof;
+}
+
+void boot_prof_import(const boot_prof_t *prev)
+{
+	boot_prof_rec_t *rec;
+	unsigned int i;
+
+	if ((prev == NULL) || (prev->magic != BOOT_PROF_MAGIC) ||
+	    (prev->version != BOOT_PROF_VERSION)) {
+		return;
+	}
+
+	assert(prev->num_records <= PLAT_BOOT_PROF_MAX_RECORDS);
+
+	for (i = 0U; i < prev->num_records; i++) {
+		rec = boot_prof_alloc();
+		if (rec == NULL) {
+			break;
+		}
+		*rec = prev->records[i];
+	}
+
+	boot_prof.dropped += prev->dropped + (prev->num_records - i);
+}
+
+void boot_prof_import_prev(void)
+{
+#if (IMAGE_BL2 && !BL2_AT_EL3) || (IMAGE_BL31 && !RESET_TO_BL31)
+	boot_prof_import(&boot_prof_prev);
+#endif
+}
+
+/*
+ * The next image reads the parameter and copies the records in its entrypoint
+ * with the MMU off, so clean both to the point of coherency. Nothing should be
+ * recorded afterwards.
+ */
+struct bl_aux_param_header *boot_prof_aux_param(void)
+{
+	boot_prof_param.h.type = BL_AUX_PARAM_BOOT_PROF;
+	boot_prof_param.h.next = 0U;
+	boot_prof_param.value = (uintptr_t)&boot_prof;
+
+	flush_dcache_range((uintptr_t)&boot_prof_param,
+			   sizeof(boot_prof_param));
+	flush_dcache_range((uintptr_t)&boot_prof, sizeof(boot_prof));
+
+	return &boot_prof_param.h;
+}
+
+/*
+ * arg4 and arg5 are only used when the platform leaves both of them zero, so
+ * that the arguments it passes to the next image are never overwritten.
+ */
+void boot_prof_handoff(entry_point_info_t *next_ep_info)
+{
+	if ((next_ep_info->args.arg4 != 0U) ||
+	    (next_ep_info->args.arg5 != 0U)) {
+		INFO("BOOT_PROF: arg4/arg5 in use, records not passed on\n");
+		return;
+	}
+
+	next_ep_info->args.arg4 = (uintptr_t)boot_prof_aux_param();
+	next_ep_info->args.arg5 = BOOT_PROF_HANDOFF_TAG;
+}
+
+/*
+ * Print the records in the format expected by tools/bootprof/bootprof.py,
+ * regardless of the log level since profiling is only enabled on purpose.
+ */
+void boot_prof_print(void)
+{
+	const boot_prof_rec_t *rec;
+	unsigned int i;
+
+	printf("BOOT_PROF: cntfrq %lu dropped %u\n",
+	       (unsigned long)read_cntfrq_el0(), boot_prof.dropped);
+
+	for (i = 0U; i < boot_prof.num_records; i++) {
+		rec = &boot_prof.records[i];
+		printf("BOOT_PROF: %llu %u %u %c %u\n",
+		       (unsigned long long)rec->timestamp, rec->stage,
+		       rec->step, (rec->end != 0U) ? 'E' : 'B', rec->arg);
+	}
+}
@@ -9,9 +9,6 @@ LIBC_SRCS	:=	$(addprefix lib/libc/,		\
 			assert.c			\
 			exit.c				\
 			memchr.c			\
-			memcmp.c			\
-			memcpy.c			\
-			memmove.c			\
 			memrchr.c			\
 			printf.c			\
 			putchar.c			\
@@ -21,7 +18,6 @@ LIBC_SRCS	:=	$(addprefix lib/libc/,		\
 			strcmp.c			\
 			strlcat.c			\
 			strlcpy.c			\
-			strlen.c			\
 			strncmp.c			\
 			strnlen.c			\
 			strrchr.c			\
@@ -33,9 +29,19 @@ LIBC_SRCS	:=	$(addprefix lib/libc/,		\
 
 ifeq (${ARCH},aarch64)
 LIBC_SRCS	+=	$(addprefix lib/libc/aarch64/,	\
+			memcmp.S			\
+			memcpy.S			\
+			memmove.S			\
 			memset.S			\
-			setjmp.S)
+			setjmp.S			\
+			strlen.S)
 else
+LIBC_SRCS	+=	$(addprefix lib/libc/,		\
+			memcmp.c			\
+			memcpy.c			\
+			memmove.c			\
+			strlen.c)
+
 LIBC_SRCS	+=	$(addprefix lib/libc/aarch32/,	\
 			memset.S)
 endif
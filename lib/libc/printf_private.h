@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PRINTF_PRIVATE_H
+#define PRINTF_PRIVATE_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+/*
+ * Destination of the formatting core shared by printf() and snprintf(). The
+ * output is accumulated in 'buf'. When it is full, 'flush' is called to empty
+ * it, or the rest of the output is dropped if 'flush' is NULL. 'count' is the
+ * number of characters output so far, including the dropped ones.
+ */
+typedef struct printf_out {
+	char *buf;
+	size_t size;
+	size_t len;
+	size_t count;
+	void (*flush)(struct printf_out *out);
+} printf_out_t;
+
+/*
+ * Format 'fmt' and 'args' into 'out'. Returns 0, or -1 on an unsupported
+ * conversion, in which case the output stops before it.
+ */
+int printf_format(printf_out_t *out, const char *fmt, va_list args);
+
+#endif /* PRINTF_PRIVATE_H */
@@ -6,239 +6,484 @@
 
 #include <assert.h>
 #include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
 #include <common/debug.h>
 #include <plat/common/platform.h>
 
-#define CHECK_AND_PUT_CHAR(buf, size, chars_printed, ch)	\
-	do {						\
-		if ((chars_printed) < (size)) {		\
-			*(buf) = (ch);			\
-			(buf)++;			\
-		}					\
-		(chars_printed)++;			\
-	} while (false)
-
-static void string_print(char **s, size_t n, size_t *chars_printed,
-			 const char *str)
+#include "printf_private.h"
+
+/* Flags of a conversion specification */
+#define FLAG_LEFT	U(0x01)		/* '-' */
+#define FLAG_ZERO	U(0x02)		/* '0' */
+#define FLAG_PLUS	U(0x04)		/* '+' */
+#define FLAG_SPACE	U(0x08)		/* ' ' */
+#define FLAG_ALT	U(0x10)		/* '#' */
+#define FLAG_UPPER	U(0x20)		/* 'X' */
+
+/* Length modifiers of a conversion specification */
+typedef enum {
+	LEN_HH,
+	LEN_H,
+	LEN_NONE,
+	LEN_L,
+	LEN_LL,
+	LEN_J,
+	LEN_Z,
+	LEN_T,
+} printf_len_t;
+
+typedef struct printf_spec {
+	unsigned int flags;
+	int width;
+	/* Precision, or -1 if none was given */
+	int prec;
+} printf_spec_t;
+
+static void out_char(printf_out_t *out, char c)
 {
-	while (*str != '\0') {
-		CHECK_AND_PUT_CHAR(*s, n, *chars_printed, *str);
-		str++;
+	if ((out->len == out->size) && (out->flush != NULL)) {
+		out->flush(out);
 	}
+
+	if (out->len < out->size) {
+		out->buf[out->len] = c;
+		out->len++;
+	}
+	out->count++;
 }
 
-static void unsigned_num_print(char **s, size_t n, size_t *chars_printed,
-			      unsigned long long int unum,
-			      unsigned int radix, char padc, int padn,
-			      bool capitalise)
+static void out_str(printf_out_t *out, const char *str, size_t len)
 {
-	/* Just need enough space to store 64 bit decimal integer */
-	char num_buf[20];
-	int i = 0;
-	int width;
-	unsigned int rem;
-	char ascii_a = capitalise ? 'A' : 'a';
+	size_t n;
 
-	do {
-		rem = unum % radix;
-		if (rem < 10U) {
-			num_buf[i] = '0' + rem;
-		} else {
-			num_buf[i] = ascii_a + (rem - 10U);
+	while (len > 0U) {
+		if ((out->len == out->size) && (out->flush != NULL)) {
+			out->flush(out);
 		}
-		i++;
-		unum /= radix;
-	} while (unum > 0U);
 
-	width = i;
-	if (padn > width) {
-		(*chars_printed) += (size_t)padn;
-	} else {
-		(*chars_printed) += (size_t)width;
+		n = out->size - out->len;
+		if (n == 0U) {
+			/* No space left, only count the rest. */
+			out->count += len;
+			return;
+		}
+		if (n > len) {
+			n = len;
+		}
+
+		(void)memcpy(&out->buf[out->len], str, n);
+		out->len += n;
+		out->count += n;
+		str += n;
+		len -= n;
 	}
+}
 
-	if (*chars_printed < n) {
+static void out_pad(printf_out_t *out, char c, int n)
+{
+	while (n > 0) {
+		out_char(out, c);
+		n--;
+	}
+}
 
-		if (padn > 0) {
-			while (width < padn) {
-				*(*s)++ = padc;
-				padn--;
-			}
+static void num_print(printf_out_t *out, unsigned long long int unum,
+		      bool negative, unsigned int radix,
+		      const printf_spec_t *spec)
+{
+	/* Enough for a 64-bit value in octal */
+	char digits[22];
+	const char *hex = ((spec->flags & FLAG_UPPER) != 0U) ?
+			  "0123456789ABCDEF" : "0123456789abcdef";
+	char prefix[2];
+	size_t plen = 0U;
+	size_t i = sizeof(digits);
+	int ndigits, zeros, pad;
+	bool zero_pad = ((spec->flags & (FLAG_ZERO | FLAG_LEFT)) == FLAG_ZERO) &&
+			(spec->prec < 0);
+
+	if (radix == 10U) {
+		while (unum != 0ULL) {
+			i--;
+			digits[i] = hex[unum % 10U];
+			unum /= 10U;
 		}
+	} else {
+		/* Avoid 64-bit divisions for the powers of two. */
+		unsigned int shift = (radix == 16U) ? 4U : 3U;
 
-		while (--i >= 0) {
-			*(*s)++ = num_buf[i];
+		while (unum != 0ULL) {
+			i--;
+			digits[i] = hex[unum & (radix - 1U)];
+			unum >>= shift;
 		}
+	}
+	ndigits = (int)(sizeof(digits) - i);
 
-		if (padn < 0) {
-			while (width < -padn) {
-				*(*s)++ = padc;
-				padn++;
-			}
+	/* Zero prints as "0", unless the precision is explicitly 0. */
+	zeros = ((spec->prec < 0) ? 1 : spec->prec) - ndigits;
+	if (zeros < 0) {
+		zeros = 0;
+	}
+
+	if (negative) {
+		prefix[plen++] = '-';
+	} else if ((spec->flags & FLAG_PLUS) != 0U) {
+		prefix[plen++] = '+';
+	} else if ((spec->flags & FLAG_SPACE) != 0U) {
+		prefix[plen++] = ' ';
+	} else if ((spec->flags & FLAG_ALT) != 0U) {
+		if ((radix == 16U) && (ndigits != 0)) {
+			prefix[plen++] = '0';
+			prefix[plen++] = ((spec->flags & FLAG_UPPER) != 0U) ?
+					 'X' : 'x';
+		} else if ((radix == 8U) && (zeros == 0)) {
+			zeros = 1;
 		}
 	}
+
+	pad = spec->width - ((int)plen + zeros + ndigits);
+
+	if (zero_pad) {
+		zeros += (pad > 0) ? pad : 0;
+		pad = 0;
+	}
+
+	if ((spec->flags & FLAG_LEFT) == 0U) {
+		out_pad(out, ' ', pad);
+	}
+	out_str(out, prefix, plen);
+	out_pad(out, '0', zeros);
+	out_str(out, &digits[i], (size_t)ndigits);
+	if ((spec->flags & FLAG_LEFT) != 0U) {
+		out_pad(out, ' ', pad);
+	}
+}
+
+static void str_print(printf_out_t *out, const char *str,
+		      const printf_spec_t *spec)
+{
+	size_t len = 0U;
+	int pad;
+
+	if (str == NULL) {
+		str = "(null)";
+	}
+
+	while ((str[len] != '\0') &&
+	       ((spec->prec < 0) || (len < (size_t)spec->prec))) {
+		len++;
+	}
+
+	pad = spec->width - (int)len;
+
+	if ((spec->flags & FLAG_LEFT) == 0U) {
+		out_pad(out, ' ', pad);
+	}
+	out_str(out, str, len);
+	if ((spec->flags & FLAG_LEFT) != 0U) {
+		out_pad(out, ' ', pad);
+	}
+}
+
+static int parse_int(const char **fmt)
+{
+	int val = 0;
+
+	while ((**fmt >= '0') && (**fmt <= '9')) {
+		val = (val * 10) + (**fmt - '0');
+		(*fmt)++;
+	}
+
+	return val;
 }
 
 /*******************************************************************
- * Reduced vsnprintf to be used for Trusted firmware.
+ * Formatting core of printf() and snprintf().
  * The following type specifiers are supported:
  *
- * %x (or %X) - hexadecimal format
  * %d or %i - signed decimal format
- * %s - string format
  * %u - unsigned decimal format
+ * %o - octal format
+ * %x (or %X) - hexadecimal format
+ * %c - character format
+ * %s - string format
  * %p - pointer format
  *
- * The following padding specifiers are supported by this print
- * %0NN - Left-pad the number with 0s (NN is a decimal number)
- * %NN - Left-pad the number or string with spaces (NN is a decimal number)
- * %-NN - Right-pad the number or string with spaces (NN is a decimal number)
+ * with the flags '-' (left-justify), '0' (pad numbers with zeros), '+' and
+ * ' ' (sign of positive numbers) and '#' (alternate form), a field width and a
+ * precision, both of which can be given as '*', and the length modifiers
+ * hh, h, l, ll, j, z and t.
  *
- * The function panics on all other formats specifiers.
- *
- * It returns the number of characters that would be written if the
- * buffer was big enough. If it returns a value lower than n, the
- * whole string has been written.
+ * Literal text is copied in runs rather than one character at a time. The
+ * output of the caller is only touched through 'out', so the formatting is
+ * reentrant.
  *******************************************************************/
-int vsnprintf(char *s, size_t n, const char *fmt, va_list args)
+int printf_format(printf_out_t *out, const char *fmt, va_list args)
 {
-	int num;
+	printf_spec_t spec;
+	printf_len_t len;
+	const char *start;
 	unsigned long long int unum;
-	char *str;
-	char padc;		/* Padding character */
-	int padn;		/* Number of characters to pad */
-	bool left;
-	bool capitalise;
-	size_t chars_printed = 0U;
-
-	if (n == 0U) {
-		/* There isn't space for anything. */
-	} else if (n == 1U) {
-		/* Buffer is too small to actually write anything else. */
-		*s = '\0';
-		n = 0U;
-	} else {
-		/* Reserve space for the terminator character. */
-		n--;
-	}
+	long long int num;
+	unsigned int radix;
+	bool more;
 
 	while (*fmt != '\0') {
-		left = false;
-		padc ='\0';
-		padn = 0;
-		capitalise = false;
-
-		if (*fmt == '%') {
+		start = fmt;
+		while ((*fmt != '\0') && (*fmt != '%')) {
 			fmt++;
-			/* Check the format specifier. */
-loop:
+		}
+		out_str(out, start, (size_t)(fmt - start));
+
+		if (*fmt == '\0') {
+			break;
+		}
+		fmt++;
+
+		/* Flags */
+		spec.flags = 0U;
+		for (more = true; more; ) {
 			switch (*fmt) {
-			case '%':
-				CHECK_AND_PUT_CHAR(s, n, chars_printed, '%');
+			case '-':
+				spec.flags |= FLAG_LEFT;
 				break;
 			case '0':
-			case '1':
-			case '2':
-			case '3':
-			case '4':
-			case '5':
-			case '6':
-			case '7':
-			case '8':
-			case '9':
-				padc = (*fmt == '0') ? '0' : ' ';
-				for (padn = 0; *fmt >= '0' && *fmt <= '9'; fmt++) {
-					padn = (padn * 10) + (*fmt - '0');
-				}
-				if (left) {
-					padn = -padn;
-				}
-				goto loop;
-			case '-':
-				left = true;
+				spec.flags |= FLAG_ZERO;
+				break;
+			case '+':
+				spec.flags |= FLAG_PLUS;
+				break;
+			case ' ':
+				spec.flags |= FLAG_SPACE;
+				break;
+			case '#':
+				spec.flags |= FLAG_ALT;
+				break;
+			default:
+				more = false;
+				break;
+			}
+			if (more) {
 				fmt++;
-				goto loop;
+			}
+		}
 
-			case 'i':
-			case 'd':
-				num = va_arg(args, int);
+		/* Field width */
+		if (*fmt == '*') {
+			spec.width = va_arg(args, int);
+			if (spec.width < 0) {
+				spec.flags |= FLAG_LEFT;
+				spec.width = -spec.width;
+			}
+			fmt++;
+		} else {
+			spec.width = parse_int(&fmt);
+		}
 
-				if (num < 0) {
-					CHECK_AND_PUT_CHAR(s, n, chars_printed,
-						'-');
-					unum = (unsigned int)-num;
-				} else {
-					unum = (unsigned int)num;
+		/* Precision */
+		spec.prec = -1;
+		if (*fmt == '.') {
+			fmt++;
+			if (*fmt == '*') {
+				spec.prec = va_arg(args, int);
+				if (spec.prec < 0) {
+					spec.prec = -1;
 				}
+				fmt++;
+			} else {
+				spec.prec = parse_int(&fmt);
+			}
+		}
+
+		/* Length modifier */
+		switch (*fmt) {
+		case 'h':
+			fmt++;
+			len = LEN_H;
+			if (*fmt == 'h') {
+				fmt++;
+				len = LEN_HH;
+			}
+			break;
+		case 'l':
+			fmt++;
+			len = LEN_L;
+			if (*fmt == 'l') {
+				fmt++;
+				len = LEN_LL;
+			}
+			break;
+		case 'j':
+			fmt++;
+			len = LEN_J;
+			break;
+		case 'z':
+			fmt++;
+			len = LEN_Z;
+			break;
+		case 't':
+			fmt++;
+			len = LEN_T;
+			break;
+		default:
+			len = LEN_NONE;
+			break;
+		}
 
-				unsigned_num_print(&s, n, &chars_printed,
-						   unum, 10, padc, padn, false);
+		/* Conversion */
+		switch (*fmt) {
+		case '%':
+			out_char(out, '%');
+			break;
+		case 'c':
+			if ((spec.flags & FLAG_LEFT) == 0U) {
+				out_pad(out, ' ', spec.width - 1);
+			}
+			out_char(out, (char)va_arg(args, int));
+			if ((spec.flags & FLAG_LEFT) != 0U) {
+				out_pad(out, ' ', spec.width - 1);
+			}
+			break;
+		case 's':
+			str_print(out, va_arg(args, const char *), &spec);
+			break;
+		case 'i':
+		case 'd':
+			switch (len) {
+			case LEN_HH:
+				num = (signed char)va_arg(args, int);
 				break;
-			case 's':
-				str = va_arg(args, char *);
-				string_print(&s, n, &chars_printed, str);
+			case LEN_H:
+				num = (short int)va_arg(args, int);
 				break;
-			case 'u':
-				unum = va_arg(args, unsigned int);
-				unsigned_num_print(&s, n, &chars_printed,
-						   unum, 10, padc, padn, false);
+			case LEN_L:
+				num = va_arg(args, long int);
 				break;
-			case 'p':
-				unum = (uintptr_t)va_arg(args, void *);
-				if (unum > 0U) {
-					string_print(&s, n, &chars_printed, "0x");
-					padn -= 2;
-				}
-				unsigned_num_print(&s, n, &chars_printed,
-						   unum, 16, padc, padn, false);
+			case LEN_LL:
+				num = va_arg(args, long long int);
 				break;
-			case 'X':
-				capitalise = true;
-			case 'x':
-				unum = va_arg(args, unsigned int);
-				unsigned_num_print(&s, n, &chars_printed,
-						   unum, 16, padc, padn,
-						   capitalise);
+			case LEN_J:
+				num = va_arg(args, intmax_t);
+				break;
+			case LEN_Z:
+				num = va_arg(args, ssize_t);
+				break;
+			case LEN_T:
+				num = va_arg(args, ptrdiff_t);
 				break;
+			default:
+				num = va_arg(args, int);
+				break;
+			}
 
+			if (num < 0) {
+				unum = 0ULL - (unsigned long long int)num;
+			} else {
+				unum = (unsigned long long int)num;
+			}
+			spec.flags &= ~FLAG_ALT;
+			num_print(out, unum, num < 0, 10U, &spec);
+			break;
+		case 'p':
+			unum = (uintptr_t)va_arg(args, void *);
+			spec.flags |= FLAG_ALT;
+			spec.flags &= ~(FLAG_PLUS | FLAG_SPACE);
+			num_print(out, unum, false, 16U, &spec);
+			break;
+		case 'X':
+			spec.flags |= FLAG_UPPER;
+			/* Fall through */
+		case 'x':
+		case 'o':
+		case 'u':
+			switch (len) {
+			case LEN_HH:
+				unum = (unsigned char)va_arg(args, unsigned int);
+				break;
+			case LEN_H:
+				unum = (unsigned short int)va_arg(args,
+								  unsigned int);
+				break;
+			case LEN_L:
+				unum = va_arg(args, unsigned long int);
+				break;
+			case LEN_LL:
+				unum = va_arg(args, unsigned long long int);
+				break;
+			case LEN_J:
+				unum = va_arg(args, uintmax_t);
+				break;
+			case LEN_Z:
+				unum = va_arg(args, size_t);
+				break;
+			case LEN_T:
+				unum = (uintptr_t)va_arg(args, ptrdiff_t);
+				break;
 			default:
-				/* Panic on any other format specifier. */
-				ERROR("snprintf: specifier with ASCII code '%d' not supported.",
-				      *fmt);
-				plat_panic_handler();
-				assert(0); /* Unreachable */
+				unum = va_arg(args, unsigned int);
+				break;
 			}
-			fmt++;
-			continue;
+
+			if (*fmt == 'u') {
+				radix = 10U;
+				spec.flags &= ~FLAG_ALT;
+			} else {
+				radix = (*fmt == 'o') ? 8U : 16U;
+			}
+			spec.flags &= ~(FLAG_PLUS | FLAG_SPACE);
+			num_print(out, unum, false, radix, &spec);
+			break;
+		default:
+			/* Stop on any other format specifier. */
+			return -1;
 		}
+		fmt++;
+	}
 
-		CHECK_AND_PUT_CHAR(s, n, chars_printed, *fmt);
+	return 0;
+}
 
-		fmt++;
+/*******************************************************************
+ * vsnprintf to be used for Trusted firmware, see printf_format()
+ * for the supported formats.
+ *
+ * The function panics on all other formats specifiers.
+ *
+ * It returns the number of characters that would be written if the
+ * buffer was big enough. If it returns a value lower than n, the
+ * whole string has been written.
+ *******************************************************************/
+int vsnprintf(char *s, size_t n, const char *fmt, va_list args)
+{
+	printf_out_t out = {
+		.buf = s,
+		/* Reserve space for the terminator character. */
+		.size = (n > 0U) ? (n - 1U) : 0U,
+		.len = 0U,
+		.count = 0U,
+		.flush = NULL,
+	};
+
+	if (printf_format(&out, fmt, args) != 0) {
+		/* Panic on any other format specifier. */
+		ERROR("snprintf: unsupported format in \"%s\"\n", fmt);
+		plat_panic_handler();
 	}
 
 	if (n > 0U) {
-		*s = '\0';
+		s[out.len] = '\0';
 	}
 
-	return (int)chars_printed;
+	return (int)out.count;
 }
 
 /*******************************************************************
- * Reduced snprintf to be used for Trusted firmware.
- * The following type specifiers are supported:
- *
- * %x (or %X) - hexadecimal format
- * %d or %i - signed decimal format
- * %s - string format
- * %u - unsigned decimal format
- * %p - pointer format
- *
- * The following padding specifiers are supported by this print
- * %0NN - Left-pad the number with 0s (NN is a decimal number)
- * %NN - Left-pad the number or string with spaces (NN is a decimal number)
- * %-NN - Right-pad the number or string with spaces (NN is a decimal number)
+ * snprintf to be used for Trusted firmware, see printf_format()
+ * for the supported formats.
  *
  * The function panics on all other formats specifiers.
  *
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+
+#include <arch_helpers.h>
+#include <lib/bakery_lock.h>
+#include <lib/spinlock.h>
+
+/*
+ * Functions in this file implement the bakery lock interface with a ticket
+ * lock, for systems built with USE_ATOMIC_BAKERY_LOCKS.
+ *
+ * The Bakery Algorithm is only needed when some contenders may access the lock
+ * with their data cache disabled or while outside of the coherency domain, in
+ * which case exclusive access instructions and atomics cannot be relied upon.
+ * When the CPUs are coherent in hardware and keep their data cache enabled for
+ * as long as they may hold a bakery lock, the lock can instead be taken with a
+ * single atomic operation when uncontended, without scanning the state of every
+ * other CPU or performing any cache maintenance. Waiters are still served in
+ * the order in which they arrived, as with the Bakery Algorithm.
+ */
+
+void bakery_lock_get(bakery_lock_t *lock)
+{
+	assert(is_dcache_enabled());
+
+	ticket_lock(lock);
+}
+
+void bakery_lock_release(bakery_lock_t *lock)
+{
+	assert(is_dcache_enabled());
+
+	ticket_unlock(lock);
+}
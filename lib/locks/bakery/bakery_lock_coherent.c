@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -166,3 +166,18 @@ void bakery_lock_release(bakery_lock_t *bakery)
 	dsb();
 	sev();
 }
+
+#if ENABLE_LOCK_PROFILING
+bool bakery_lock_is_contended(bakery_lock_t *bakery)
+{
+	unsigned int they, me = plat_my_core_pos();
+
+	for (they = 0U; they < BAKERY_LOCK_MAX_CPUS; they++) {
+		if ((they != me) && (bakery->lock_data[they] != 0U)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
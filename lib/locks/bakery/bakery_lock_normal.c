@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2021, ARM Limited and Contributors. All rights reserved.
  * Copyright (c) 2020, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -248,3 +248,26 @@ void bakery_lock_release(bakery_lock_t *lock)
 	/* This sev is ordered by the dsbish in write_cahce_op */
 	sev();
 }
+
+#if ENABLE_LOCK_PROFILING
+bool bakery_lock_is_contended(bakery_lock_t *lock)
+{
+	unsigned int they, me = plat_my_core_pos();
+	bool is_cached = is_dcache_enabled();
+	bakery_info_t *their_bakery_info;
+
+	for (they = 0U; they < BAKERY_LOCK_MAX_CPUS; they++) {
+		if (they == me) {
+			continue;
+		}
+
+		their_bakery_info = get_bakery_info(they, lock);
+		read_cache_op((uintptr_t)their_bakery_info, is_cached);
+		if (their_bakery_info->lock_data != 0U) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
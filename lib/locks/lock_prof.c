@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Lock contention profiler.
+ *
+ * When ENABLE_LOCK_PROFILING=1, BL31 is linked with --wrap for each lock and
+ * unlock function, so that every call lands in one of the __wrap_*() functions
+ * below before reaching the real lock. Each acquisition is accounted to the
+ * call site, identified by its return address, in a table private to the
+ * calling CPU. Only the owning CPU updates its table, so no locking or atomic
+ * operation is needed, and the profiler never takes a lock itself.
+ *
+ * An acquisition is counted as contended when the state of the lock, sampled
+ * before the call, shows that another CPU holds it or is waiting for it. For
+ * bakery locks this is the state of all the CPUs, which some of them may update
+ * with their data cache off on the power down path, so it is a hint only.
+ *
+ * To report which CPU was holding a lock when another one had to wait for it,
+ * a small table maps lock addresses to their current holder. It is indexed by
+ * a hash of the lock address, so colliding locks may occasionally hide each
+ * other's holder, in which case the holder is reported as unknown.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <bl31/ns_buf.h>
+#include <common/debug.h>
+#include <lib/bakery_lock.h>
+#include <lib/lock_prof.h>
+#include <lib/spinlock.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+#include <smccc_helpers.h>
+
+#include <platform_def.h>
+
+#ifndef PLAT_LOCK_PROF_NUM_HOLDERS
+#define PLAT_LOCK_PROF_NUM_HOLDERS	U(64)
+#endif
+
+CASSERT(IS_POWER_OF_TWO(PLAT_LOCK_PROF_NUM_HOLDERS),
+	assert_lock_prof_num_holders_power_of_two);
+CASSERT(PLATFORM_CORE_COUNT < 0xffU, assert_lock_prof_holder_cpu_fits);
+
+typedef struct lock_prof_cpu {
+	lock_prof_site_t sites[PLAT_LOCK_PROF_MAX_SITES];
+	/* Acquisitions which couldn't be recorded as the table was full */
+	uint64_t dropped;
+} __aligned(CACHE_WRITEBACK_GRANULE) lock_prof_cpu_t;
+
+static lock_prof_cpu_t lock_prof_cpus[PLATFORM_CORE_COUNT];
+
+/*
+ * Each entry holds the address of a lock in bits [63:8] and the index of its
+ * holder plus one in bits [7:0], so that it can be updated with a single store.
+ */
+static volatile uint64_t lock_prof_holders[PLAT_LOCK_PROF_NUM_HOLDERS];
+
+void __real_spin_lock(spinlock_t *lock);
+void __real_spin_unlock(spinlock_t *lock);
+void __real_ticket_lock(ticketlock_t *lock);
+void __real_ticket_unlock(ticketlock_t *lock);
+void __real_bakery_lock_get(bakery_lock_t *lock);
+void __real_bakery_lock_release(bakery_lock_t *lock);
+
+static inline volatile uint64_t *holder_entry(uintptr_t lock)
+{
+	return &lock_prof_holders[(lock >> 2) &
+				  (PLAT_LOCK_PROF_NUM_HOLDERS - 1U)];
+}
+
+static inline uint64_t holder_value(uintptr_t lock, unsigned int cpu)
+{
+	return ((uint64_t)lock << 8) | (uint64_t)(cpu + 1U);
+}
+
+/* Return the CPU holding 'lock', or LOCK_PROF_NO_HOLDER if not known */
+static unsigned int lock_prof_holder(uintptr_t lock)
+{
+	uint64_t val = *holder_entry(lock);
+
+	if (((val >> 8) != (uint64_t)lock) || ((val & 0xffU) == 0U)) {
+		return LOCK_PROF_NO_HOLDER;
+	}
+
+	return (unsigned int)(val & 0xffU) - 1U;
+}
+
+static lock_prof_site_t *lock_prof_find_site(lock_prof_cpu_t *cpu,
+					     uintptr_t site)
+{
+	unsigned int i;
+
+	for (i = 0U; i < PLAT_LOCK_PROF_MAX_SITES; i++) {
+		if (cpu->sites[i].site == site) {
+			return &cpu->sites[i];
+		}
+
+		if (cpu->sites[i].site == 0U) {
+			cpu->sites[i].site = site;
+			cpu->sites[i].last_holder = LOCK_PROF_NO_HOLDER;
+			return &cpu->sites[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Account for an acquisition of 'lock' from 'site' by this CPU */
+static void lock_prof_acquired(uintptr_t lock, uintptr_t site,
+			       bool contended, unsigned int holder,
+			       uint64_t start)
+{
+	unsigned int me = plat_my_core_pos();
+	uint64_t wait = read_cntpct_el0() - start;
+	lock_prof_cpu_t *cpu = &lock_prof_cpus[me];
+	lock_prof_site_t *s;
+
+	*holder_entry(lock) = holder_value(lock, me);
+
+	s = lock_prof_find_site(cpu, site);
+	if (s == NULL) {
+		cpu->dropped++;
+		return;
+	}
+
+	s->lock = lock;
+	s->acquires++;
+	s->wait_ticks += wait;
+	if (wait > s->max_wait_ticks) {
+		s->max_wait_ticks = wait;
+	}
+
+	if (contended) {
+		s->contended++;
+		s->last_holder = holder;
+	}
+}
+
+static void lock_prof_released(uintptr_t lock)
+{
+	volatile uint64_t *entry = holder_entry(lock);
+
+	if (*entry == holder_value(lock, plat_my_core_pos())) {
+		*entry = 0U;
+	}
+}
+
+static inline bool ticket_lock_is_contended(const ticketlock_t *lock)
+{
+	uint32_t val = lock->lock;
+
+	return (val >> TICKETLOCK_NEXT_SHIFT) != (val & 0xffffU);
+}
+
+void __wrap_spin_lock(spinlock_t *lock)
+{
+	uintptr_t site = (uintptr_t)__builtin_return_address(0);
+	uint64_t start = read_cntpct_el0();
+	bool contended = (lock->lock != 0U);
+	unsigned int holder = LOCK_PROF_NO_HOLDER;
+
+	if (contended) {
+		holder = lock_prof_holder((uintptr_t)lock);
+	}
+
+	__real_spin_lock(lock);
+	lock_prof_acquired((uintptr_t)lock, site, contended, holder, start);
+}
+
+void __wrap_spin_unlock(spinlock_t *lock)
+{
+	lock_prof_released((uintptr_t)lock);
+	__real_spin_unlock(lock);
+}
+
+void __wrap_ticket_lock(ticketlock_t *lock)
+{
+	uintptr_t site = (uintptr_t)__builtin_return_address(0);
+	uint64_t start = read_cntpct_el0();
+	bool contended = ticket_lock_is_contended(lock);
+	unsigned int holder = LOCK_PROF_NO_HOLDER;
+
+	if (contended) {
+		holder = lock_prof_holder((uintptr_t)lock);
+	}
+
+	__real_ticket_lock(lock);
+	lock_prof_acquired((uintptr_t)lock, site, contended, holder, start);
+}
+
+void __wrap_ticket_unlock(ticketlock_t *lock)
+{
+	lock_prof_released((uintptr_t)lock);
+	__real_ticket_unlock(lock);
+}
+
+/*
+ * With USE_ATOMIC_BAKERY_LOCKS=1, bakery locks are ticket locks and
+ * bakery_lock_get() would go through __wrap_ticket_lock() as well, so the
+ * ticket lock is taken directly to account for each acquisition only once.
+ */
+void __wrap_bakery_lock_get(bakery_lock_t *lock)
+{
+	uintptr_t site = (uintptr_t)__builtin_return_address(0);
+	uint64_t start = read_cntpct_el0();
+	unsigned int holder = LOCK_PROF_NO_HOLDER;
+	bool contended;
+
+#if USE_ATOMIC_BAKERY_LOCKS
+	contended = ticket_lock_is_contended(lock);
+#else
+	contended = bakery_lock_is_contended(lock);
+#endif
+	if (contended) {
+		holder = lock_prof_holder((uintptr_t)lock);
+	}
+
+#if USE_ATOMIC_BAKERY_LOCKS
+	assert(is_dcache_enabled());
+	__real_ticket_lock(lock);
+#else
+	__real_bakery_lock_get(lock);
+#endif
+	lock_prof_acquired((uintptr_t)lock, site, contended, holder, start);
+}
+
+void __wrap_bakery_lock_release(bakery_lock_t *lock)
+{
+	lock_prof_released((uintptr_t)lock);
+#if USE_ATOMIC_BAKERY_LOCKS
+	assert(is_dcache_enabled());
+	__real_ticket_unlock(lock);
+#else
+	__real_bakery_lock_release(lock);
+#endif
+}
+
+void lock_prof_print(void)
+{
+	unsigned int cpu, i;
+	const lock_prof_site_t *s;
+
+	printf("Lock contention (times in counter ticks):\n");
+	for (cpu = 0U; cpu < PLATFORM_CORE_COUNT; cpu++) {
+		for (i = 0U; i < PLAT_LOCK_PROF_MAX_SITES; i++) {
+			s = &lock_prof_cpus[cpu].sites[i];
+			if (s->site == 0U) {
+				break;
+			}
+
+			printf("cpu%u site 0x%llx lock 0x%llx: %u acquired, %u contended, wait %llu (max %llu)",
+			       cpu, s->site, s->lock, s->acquires, s->contended,
+			       s->wait_ticks, s->max_wait_ticks);
+			if (s->last_holder != LOCK_PROF_NO_HOLDER) {
+				printf(", last held by cpu%u", s->last_holder);
+			}
+			printf("\n");
+		}
+
+		if (lock_prof_cpus[cpu].dropped != 0U) {
+			printf("cpu%u: %llu acquisitions not recorded\n", cpu,
+			       lock_prof_cpus[cpu].dropped);
+		}
+	}
+}
+
+#if NS_SHARED_BUF_SUPPORT
+/*
+ * x1: index of the CPU whose statistics are requested
+ * x2: offset in the Non-secure shared buffer of the caller
+ *
+ * Copies as many lock_prof_site_t as fit in the shared buffer, starting at
+ * x2, and returns the status in x0, the number of sites copied in x1 and the
+ * number of acquisitions which weren't recorded in x2.
+ */
+static uintptr_t lock_prof_get(u_register_t x1, u_register_t x2, void *handle)
+{
+	const lock_prof_cpu_t *cpu;
+	unsigned int n;
+	size_t avail;
+
+	if ((x1 >= PLATFORM_CORE_COUNT) || (x2 > ns_buf_size())) {
+		SMC_RET1(handle, LOCK_PROF_E_INVALID_PARAMS);
+	}
+
+	cpu = &lock_prof_cpus[x1];
+
+	for (n = 0U; n < PLAT_LOCK_PROF_MAX_SITES; n++) {
+		if (cpu->sites[n].site == 0U) {
+			break;
+		}
+	}
+
+	avail = (ns_buf_size() - x2) / sizeof(lock_prof_site_t);
+	if (n > avail) {
+		n = (unsigned int)avail;
+	}
+
+	if ((n != 0U) &&
+	    (ns_buf_write(x2, cpu->sites, n * sizeof(lock_prof_site_t)) != 0)) {
+		SMC_RET1(handle, LOCK_PROF_E_INVALID_PARAMS);
+	}
+
+	SMC_RET3(handle, LOCK_PROF_E_SUCCESS, n, cpu->dropped);
+}
+#endif /* NS_SHARED_BUF_SUPPORT */
+
+uintptr_t lock_prof_smc_handler(uint32_t smc_fid,
+				u_register_t x1,
+				u_register_t x2,
+				u_register_t x3,
+				u_register_t x4,
+				void *cookie,
+				void *handle,
+				u_register_t flags)
+{
+	if (is_caller_secure(flags)) {
+		SMC_RET1(handle, LOCK_PROF_E_DENIED);
+	}
+
+	switch (smc_fid) {
+#if NS_SHARED_BUF_SUPPORT
+	case VEN_EL3_LOCK_PROF_GET:
+		return lock_prof_get(x1, x2, handle);
+#endif
+
+	case VEN_EL3_LOCK_PROF_PRINT:
+		lock_prof_print();
+		SMC_RET1(handle, LOCK_PROF_E_SUCCESS);
+
+	default:
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
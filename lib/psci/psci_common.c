@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -891,7 +891,7 @@ int psci_spd_migrate_info(u_register_t *mpidr)
  ******************************************************************************/
 void psci_print_power_domain_map(void)
 {
-#if LOG_LEVEL >= LOG_LEVEL_INFO
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_INFO
 	unsigned int idx;
 	plat_local_state_t state;
 	plat_local_state_type_t state_type;
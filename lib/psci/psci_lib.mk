@@ -24,7 +24,9 @@ ifeq (${ARCH}, aarch64)
 PSCI_LIB_SOURCES	+=	lib/el3_runtime/aarch64/context.S
 endif
 
-ifeq (${USE_COHERENT_MEM}, 1)
+ifeq (${USE_ATOMIC_BAKERY_LOCKS}, 1)
+PSCI_LIB_SOURCES		+=	lib/locks/bakery/bakery_lock_atomic.c
+else ifeq (${USE_COHERENT_MEM}, 1)
 PSCI_LIB_SOURCES		+=	lib/locks/bakery/bakery_lock_coherent.c
 else
 PSCI_LIB_SOURCES		+=	lib/locks/bakery/bakery_lock_normal.c
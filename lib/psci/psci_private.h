@@ -165,10 +165,11 @@ typedef struct cpu_pwr_domain_node {
  ******************************************************************************/
 #if HW_ASSISTED_COHERENCY
 /*
- * On systems where participant CPUs are cache-coherent, we can use spinlocks
- * instead of bakery locks.
+ * On systems where participant CPUs are cache-coherent, we can use ticket
+ * locks instead of bakery locks. Unlike plain spinlocks, they hand the lock
+ * over fairly when many CPUs enter or leave a power domain together.
  */
-#define DEFINE_PSCI_LOCK(_name)		spinlock_t _name
+#define DEFINE_PSCI_LOCK(_name)		ticketlock_t _name
 #define DECLARE_PSCI_LOCK(_name)	extern DEFINE_PSCI_LOCK(_name)
 
 /* One lock is required per non-CPU power domain node */
@@ -195,12 +196,12 @@ static inline void psci_dsbish(void)
 
 static inline void psci_lock_get(non_cpu_pd_node_t *non_cpu_pd_node)
 {
-	spin_lock(&psci_locks[non_cpu_pd_node->lock_index]);
+	ticket_lock(&psci_locks[non_cpu_pd_node->lock_index]);
 }
 
 static inline void psci_lock_release(non_cpu_pd_node_t *non_cpu_pd_node)
 {
-	spin_unlock(&psci_locks[non_cpu_pd_node->lock_index]);
+	ticket_unlock(&psci_locks[non_cpu_pd_node->lock_index]);
 }
 
 #else /* if HW_ASSISTED_COHERENCY == 0 */
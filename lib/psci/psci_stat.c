@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,7 @@
 #include <platform_def.h>
 
 #include <common/debug.h>
+#include <lib/seqlock.h>
 #include <plat/common/platform.h>
 
 #include "psci_private.h"
@@ -39,6 +40,16 @@ static psci_stat_t psci_cpu_stat[PLATFORM_CORE_COUNT]
 static psci_stat_t psci_non_cpu_stat[PSCI_NUM_NON_CPU_PWR_DOMAINS]
 				[PLAT_MAX_PWR_LVL_STATES];
 
+/*
+ * Protect the residency and count of each entry of the above arrays, so that
+ * PSCI_STAT_RESIDENCY and PSCI_STAT_COUNT callers read a consistent pair
+ * without holding up the CPUs which are powering up. CPU stats are only
+ * updated by the CPU they belong to, and non CPU stats are updated with the
+ * power domain lock held, so no further writer lock is needed.
+ */
+static seqcount_t psci_cpu_stat_seq[PLATFORM_CORE_COUNT];
+static seqcount_t psci_non_cpu_stat_seq[PSCI_NUM_NON_CPU_PWR_DOMAINS];
+
 /*
  * This functions returns the index into the `psci_stat_t` array given the
  * local power state and power domain level. If the platform implements the
@@ -127,8 +138,10 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 	    state_info, cpu_idx);
 
 	/* Update CPU stats. */
+	write_seqcount_begin(&psci_cpu_stat_seq[cpu_idx]);
 	psci_cpu_stat[cpu_idx][stat_idx].residency += residency;
 	psci_cpu_stat[cpu_idx][stat_idx].count++;
+	write_seqcount_end(&psci_cpu_stat_seq[cpu_idx]);
 
 	/*
 	 * Check what power domains above CPU were off
@@ -159,8 +172,10 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 		stat_idx = get_stat_idx(local_state, lvl);
 
 		/* Update non cpu stats */
+		write_seqcount_begin(&psci_non_cpu_stat_seq[parent_idx]);
 		psci_non_cpu_stat[parent_idx][stat_idx].residency += residency;
 		psci_non_cpu_stat[parent_idx][stat_idx].count++;
+		write_seqcount_end(&psci_non_cpu_stat_seq[parent_idx]);
 
 		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
@@ -178,6 +193,7 @@ static int psci_get_stat(u_register_t target_cpu, unsigned int power_state,
 	int rc;
 	unsigned int pwrlvl, lvl, parent_idx, target_idx;
 	int stat_idx;
+	uint32_t seq;
 	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
 	plat_local_state_t local_state;
 
@@ -214,10 +230,20 @@ static int psci_get_stat(u_register_t target_cpu, unsigned int power_state,
 			parent_idx = SPECULATION_SAFE_VALUE(psci_non_cpu_pd_nodes[parent_idx].parent_node);
 
 		/* Get the non cpu power domain stats */
-		*psci_stat = psci_non_cpu_stat[parent_idx][stat_idx];
+		do {
+			seq = read_seqcount_begin(
+					&psci_non_cpu_stat_seq[parent_idx]);
+			*psci_stat = psci_non_cpu_stat[parent_idx][stat_idx];
+		} while (read_seqcount_retry(
+					&psci_non_cpu_stat_seq[parent_idx], seq));
 	} else {
 		/* Get the cpu power domain stats */
-		*psci_stat = psci_cpu_stat[target_idx][stat_idx];
+		do {
+			seq = read_seqcount_begin(
+					&psci_cpu_stat_seq[target_idx]);
+			*psci_stat = psci_cpu_stat[target_idx][stat_idx];
+		} while (read_seqcount_retry(
+					&psci_cpu_stat_seq[target_idx], seq));
 	}
 
 	return PSCI_E_SUCCESS;
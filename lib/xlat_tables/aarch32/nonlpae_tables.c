@@ -151,7 +151,7 @@ static mmap_region_t mmap[MAX_MMAP_REGIONS + 1];
 
 void print_mmap(void)
 {
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 	mmap_region_t *mm = mmap;
 
 	printf("init xlat - l1:%p  l2:%p (%d)\n",
@@ -330,7 +330,7 @@ static uint32_t mmap_desc(unsigned attr, unsigned int addr_pa,
 	default:
 		panic();
 	}
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 	/* dump only the non-lpae level 2 tables */
 	if (level == 2U) {
 		printf(attr & MT_MEMORY ? "MEM" : "dev");
@@ -415,7 +415,7 @@ static mmap_region_t *init_xlation_table_inner(mmap_region_t *mm,
 			++mm;
 			continue;
 		}
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 		/* dump only non-lpae level 2 tables content */
 		if (level == 2U) {
 			printf("      0x%lx %x " + 6 - 2 * level,
@@ -473,7 +473,7 @@ static mmap_region_t *init_xlation_table_inner(mmap_region_t *mm,
 						(uint32_t *)xlat_table,
 						level + 1);
 		}
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 		/* dump only non-lpae level 2 tables content */
 		if (level == 2U) {
 			printf("\n");
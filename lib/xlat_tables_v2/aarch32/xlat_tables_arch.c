@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -86,6 +86,16 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime)
 	}
 }
 
+static void tlbi_va_regime(uintptr_t va, int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		tlbimvaais(TLBI_ADDR(va));
+	} else {
+		assert(xlat_regime == EL2_REGIME);
+		tlbimvahis(TLBI_ADDR(va));
+	}
+}
+
 void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 {
 	/*
@@ -94,12 +104,32 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	 */
 	dsbishst();
 
-	if (xlat_regime == EL1_EL0_REGIME) {
-		tlbimvaais(TLBI_ADDR(va));
+	tlbi_va_regime(va, xlat_regime);
+}
+
+void xlat_arch_tlbi_batch_flush(const xlat_tlbi_batch_t *batch)
+{
+	if (batch->num_va == 0U)
+		return;
+
+	/*
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
+	 */
+	dsbishst();
+
+	if (batch->num_va <= XLAT_TLBI_BATCH_SIZE) {
+		for (unsigned int i = 0U; i < batch->num_va; i++)
+			tlbi_va_regime(batch->va[i], batch->xlat_regime);
+	} else if (batch->xlat_regime == EL1_EL0_REGIME) {
+		/* There are no TLBI range operations in AArch32 */
+		tlbiallis();
 	} else {
-		assert(xlat_regime == EL2_REGIME);
-		tlbimvahis(TLBI_ADDR(va));
+		assert(batch->xlat_regime == EL2_REGIME);
+		tlbiallhis();
 	}
+
+	xlat_arch_tlbi_va_sync();
 }
 
 void xlat_arch_tlbi_va_sync(void)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -157,14 +157,8 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime)
 	}
 }
 
-void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
+static void tlbi_va_regime(uintptr_t va, int xlat_regime)
 {
-	/*
-	 * Ensure the translation table write has drained into memory before
-	 * invalidating the TLB entry.
-	 */
-	dsbishst();
-
 	/*
 	 * This function only supports invalidation of TLB entries for the EL3
 	 * and EL1&0 translation regimes.
@@ -185,6 +179,111 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
+{
+	/*
+	 * Ensure the translation table write has drained into memory before
+	 * invalidating the TLB entry.
+	 */
+	dsbishst();
+
+	tlbi_va_regime(va, xlat_regime);
+}
+
+static void tlbi_all_regime(int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		assert(xlat_arch_current_el() >= 1U);
+		tlbivmalle1is();
+	} else if (xlat_regime == EL2_REGIME) {
+		assert(xlat_arch_current_el() >= 2U);
+		tlbialle2is();
+	} else {
+		assert(xlat_regime == EL3_REGIME);
+		assert(xlat_arch_current_el() >= 3U);
+		tlbialle3is();
+	}
+}
+
+/*
+ * Invalidates 'pages' pages from 'va' with as few TLBI range operations as
+ * possible. Each operation covers a multiple of 2^(5 * SCALE + 1) pages, so the
+ * number of pages is consumed 5 bits at a time, starting from the lowest ones.
+ */
+static void tlbi_range_regime(uintptr_t va, unsigned long long pages,
+			      int xlat_regime)
+{
+	unsigned int scale = 0U;
+	unsigned long long num;
+	uint64_t op;
+
+	assert(pages < TLBIR_MAX_PAGES);
+
+	while (pages > 0U) {
+		/* An odd number of pages can't be described by a range */
+		if ((pages & 1U) != 0U) {
+			tlbi_va_regime(va, xlat_regime);
+			va += PAGE_SIZE;
+			pages--;
+			continue;
+		}
+
+		num = (pages >> ((5U * scale) + 1U)) & TLBIR_NUM_MASK;
+		if (num != 0U) {
+			op = TLBIR_TG_4KB |
+			     ((uint64_t)scale << TLBIR_SCALE_SHIFT) |
+			     ((num - 1U) << TLBIR_NUM_SHIFT) |
+			     (TLBI_ADDR(va) & TLBIR_BADDR_MASK);
+
+			if (xlat_regime == EL1_EL0_REGIME) {
+				tlbirvaae1is(op);
+			} else if (xlat_regime == EL2_REGIME) {
+				tlbirvae2is(op);
+			} else {
+				tlbirvae3is(op);
+			}
+
+			num <<= (5U * scale) + 1U;
+			va += (uintptr_t)num * PAGE_SIZE;
+			pages -= num;
+		}
+
+		scale++;
+	}
+}
+
+void xlat_arch_tlbi_batch_flush(const xlat_tlbi_batch_t *batch)
+{
+	unsigned long long pages;
+
+	if (batch->num_va == 0U)
+		return;
+
+	/*
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
+	 */
+	dsbishst();
+
+	if (batch->num_va <= XLAT_TLBI_BATCH_SIZE) {
+		for (unsigned int i = 0U; i < batch->num_va; i++)
+			tlbi_va_regime(batch->va[i], batch->xlat_regime);
+	} else {
+		pages = ((batch->max_va - batch->min_va) >> PAGE_SIZE_SHIFT) +
+			1U;
+
+		if (is_armv8_4_tlbi_range_present() &&
+		    (pages < TLBIR_MAX_PAGES)) {
+			tlbi_range_regime(batch->min_va, pages,
+					  batch->xlat_regime);
+		} else {
+			tlbi_all_regime(batch->xlat_regime);
+		}
+	}
+
+	xlat_arch_tlbi_va_sync();
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/*
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -28,6 +28,40 @@ static inline __attribute__((unused)) void xlat_clean_dcache_range(uintptr_t add
 		clean_dcache_range(addr, size);
 }
 
+void xlat_tlbi_batch_init(xlat_tlbi_batch_t *batch, int xlat_regime)
+{
+	batch->xlat_regime = xlat_regime;
+	batch->num_va = 0U;
+	batch->min_va = UINTPTR_MAX;
+	batch->max_va = 0U;
+}
+
+void xlat_tlbi_batch_add(xlat_tlbi_batch_t *batch, uintptr_t va, size_t size)
+{
+	if (batch->num_va < XLAT_TLBI_BATCH_SIZE)
+		batch->va[batch->num_va] = va;
+
+	/* Saturate so that the counter can't wrap back to a small value. */
+	if (batch->num_va <= XLAT_TLBI_BATCH_SIZE)
+		batch->num_va++;
+
+	if (va < batch->min_va)
+		batch->min_va = va;
+	if ((va + size - 1U) > batch->max_va)
+		batch->max_va = va + size - 1U;
+}
+
+/*
+ * Marks all the entries of a translation table as invalid. Tables are only
+ * initialized when they are first allocated, so that the spare tables of a
+ * context aren't written at boot, when the MMU and data cache are still off.
+ */
+static void xlat_table_init(uint64_t *table)
+{
+	for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++)
+		table[i] = INVALID_DESC;
+}
+
 #if PLAT_XLAT_TABLES_DYNAMIC
 
 /*
@@ -42,27 +76,43 @@ static inline __attribute__((unused)) void xlat_clean_dcache_range(uintptr_t add
  */
 static int xlat_table_get_index(const xlat_ctx_t *ctx, const uint64_t *table)
 {
-	for (int i = 0; i < ctx->tables_num; i++)
-		if (ctx->tables[i] == table)
-			return i;
+	uintptr_t offset = (uintptr_t)table - (uintptr_t)ctx->tables;
 
 	/*
 	 * Maybe we were asked to get the index of the base level table, which
 	 * should never happen.
 	 */
-	assert(false);
+	assert((uintptr_t)table >= (uintptr_t)ctx->tables);
+	assert((offset % XLAT_TABLE_SIZE) == 0U);
+	assert((offset / XLAT_TABLE_SIZE) < (uintptr_t)ctx->tables_num);
 
-	return -1;
+	return (int)(offset / XLAT_TABLE_SIZE);
 }
 
-/* Returns a pointer to an empty translation table. */
-static uint64_t *xlat_table_get_empty(const xlat_ctx_t *ctx)
+/*
+ * Returns a pointer to an empty translation table, or NULL if all of them are
+ * in use. Tables that have been released are reused first, then the ones that
+ * have never been used, so that ctx->next_table is the maximum number of
+ * tables that have been in use at the same time.
+ */
+static uint64_t *xlat_table_get_empty(xlat_ctx_t *ctx)
 {
-	for (int i = 0; i < ctx->tables_num; i++)
-		if (ctx->tables_mapped_regions[i] == 0)
-			return ctx->tables[i];
+	uint64_t *table = ctx->free_tables;
+
+	if (table != NULL) {
+		ctx->free_tables = (uint64_t *)(uintptr_t)table[0];
+	} else if (ctx->next_table < ctx->tables_num) {
+		table = ctx->tables[ctx->next_table++];
+	} else {
+		return NULL;
+	}
+
+	assert(ctx->tables_mapped_regions[xlat_table_get_index(ctx, table)]
+	       == 0);
 
-	return NULL;
+	xlat_table_init(table);
+
+	return table;
 }
 
 /* Increments region count for a given table. */
@@ -89,12 +139,36 @@ static bool xlat_table_is_empty(const xlat_ctx_t *ctx, const uint64_t *table)
 	return ctx->tables_mapped_regions[xlat_table_get_index(ctx, table)] == 0;
 }
 
+/*
+ * Returns a table that no longer has any region mapped to the free list. The
+ * list is linked through the first entry of each table. Tables are aligned, so
+ * the link looks like an invalid descriptor to any table walk that still goes
+ * through the table until the TLB invalidations are complete.
+ */
+static void xlat_table_release(xlat_ctx_t *ctx, uint64_t *table)
+{
+	assert(xlat_table_is_empty(ctx, table));
+
+	table[0] = (uint64_t)(uintptr_t)ctx->free_tables;
+	ctx->free_tables = table;
+
+	/* The table may be the one remembered by the lookup cache. */
+	if (ctx->lookup_cache != NULL)
+		*ctx->lookup_cache = 0U;
+}
+
 #else /* PLAT_XLAT_TABLES_DYNAMIC */
 
-/* Returns a pointer to the first empty translation table. */
+/*
+ * Returns a pointer to the first empty translation table, or NULL if all of
+ * them are in use.
+ */
 static uint64_t *xlat_table_get_empty(xlat_ctx_t *ctx)
 {
-	assert(ctx->next_table < ctx->tables_num);
+	if (ctx->next_table >= ctx->tables_num)
+		return NULL;
+
+	xlat_table_init(ctx->tables[ctx->next_table]);
 
 	return ctx->tables[ctx->next_table++];
 }
@@ -355,7 +429,8 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				     const uintptr_t table_base_va,
 				     uint64_t *const table_base,
 				     const unsigned int table_entries,
-				     const unsigned int level)
+				     const unsigned int level,
+				     xlat_tlbi_batch_t *batch)
 {
 	assert((level >= ctx->base_level) && (level <= XLAT_TABLE_LEVEL_MAX));
 
@@ -386,7 +461,8 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 		if (action == ACTION_WRITE_BLOCK_ENTRY) {
 
 			table_base[table_idx] = INVALID_DESC;
-			xlat_arch_tlbi_va(table_idx_va, ctx->xlat_regime);
+			xlat_tlbi_batch_add(batch, table_idx_va,
+					    XLAT_BLOCK_SIZE(level));
 
 		} else if (action == ACTION_RECURSE_INTO_TABLE) {
 
@@ -395,7 +471,7 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 			/* Recurse to write into subtable */
 			xlat_tables_unmap_region(ctx, mm, table_idx_va,
 						 subtable, XLAT_TABLE_ENTRIES,
-						 level + 1U);
+						 level + 1U, batch);
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
 			xlat_clean_dcache_range((uintptr_t)subtable,
 				XLAT_TABLE_ENTRIES * sizeof(uint64_t));
@@ -405,8 +481,9 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 			 */
 			if (xlat_table_is_empty(ctx, subtable)) {
 				table_base[table_idx] = INVALID_DESC;
-				xlat_arch_tlbi_va(table_idx_va,
-						  ctx->xlat_regime);
+				xlat_tlbi_batch_add(batch, table_idx_va,
+						    XLAT_BLOCK_SIZE(level));
+				xlat_table_release(ctx, subtable);
 			}
 
 		} else {
@@ -425,6 +502,38 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 		xlat_table_dec_regions_count(ctx, table_base);
 }
 
+/*
+ * Undoes the changes done to a subtable when mapping a region failed before
+ * anything could be written to it. Unmapping the part of the region that was
+ * mapped doesn't go through such a subtable, so its region count would never
+ * drop back and a table created for the region would never be released.
+ */
+static void xlat_tables_map_region_undo(xlat_ctx_t *ctx,
+					uint64_t *const table_base,
+					unsigned int table_idx,
+					uintptr_t table_idx_va,
+					uint64_t *subtable, bool created)
+{
+	xlat_table_dec_regions_count(ctx, subtable);
+
+	if (!created)
+		return;
+
+	table_base[table_idx] = INVALID_DESC;
+
+	/* The table descriptor may have been cached by a table walk. */
+	if (ctx->initialized) {
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+		xlat_clean_dcache_range((uintptr_t)&table_base[table_idx],
+					sizeof(uint64_t));
+#endif
+		xlat_arch_tlbi_va(table_idx_va, ctx->xlat_regime);
+		xlat_arch_tlbi_va_sync();
+	}
+
+	xlat_table_release(ctx, subtable);
+}
+
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
 /*
@@ -558,6 +667,54 @@ static action_t xlat_tables_map_region_action(const mmap_region_t *mm,
 	}
 }
 
+#if XLAT_TABLES_CONT_HINT
+/*
+ * Returns the Contiguous hint for the run of XLAT_CONT_ENTRIES descriptors that
+ * starts at the given table entry, or 0 if it can't have it. The run must be
+ * aligned, and all of its entries must be written by this region as block or
+ * page descriptors, so that they translate it to consecutive output addresses.
+ * Entries of overlapping static regions are left untouched, which leaves their
+ * run without the hint.
+ *
+ * The hint is worked out before any descriptor of the run is written, so that
+ * each of them is written once with its final value. Dynamic regions are
+ * mapped with the MMU on, and adding the hint to live descriptors afterwards
+ * would require a break-before-make sequence.
+ */
+static uint64_t xlat_tables_cont_hint(const mmap_region_t *mm,
+				      uintptr_t run_va,
+				      const uint64_t *run,
+				      unsigned int entries_left,
+				      unsigned int level)
+{
+	uintptr_t mm_end_va = mm->base_va + mm->size - 1U;
+	unsigned long long run_pa = mm->base_pa + run_va - mm->base_va;
+	unsigned int i;
+
+	if ((level < MIN_LVL_BLOCK_DESC) || (entries_left < XLAT_CONT_ENTRIES))
+		return 0U;
+
+	/* The run must be fully covered by the region. */
+	if ((run_va < mm->base_va) ||
+	    ((run_va + XLAT_CONT_SIZE(level) - 1U) > mm_end_va))
+		return 0U;
+
+	if ((run_pa & XLAT_CONT_MASK(level)) != 0U)
+		return 0U;
+
+	for (i = 0U; i < XLAT_CONT_ENTRIES; i++) {
+		if (xlat_tables_map_region_action(mm,
+			(uint32_t)(run[i] & DESC_MASK),
+			run_pa + (i * XLAT_BLOCK_SIZE(level)),
+			run_va + (i * XLAT_BLOCK_SIZE(level)), level) !=
+		    ACTION_WRITE_BLOCK_ENTRY)
+			return 0U;
+	}
+
+	return UPPER_ATTRS(CONT_HINT);
+}
+#endif /* XLAT_TABLES_CONT_HINT */
+
 /*
  * Recursive function that writes to the translation tables and maps the
  * specified region. On success, it returns the VA of the last byte that was
@@ -579,6 +736,7 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 
 	uint64_t *subtable;
 	uint64_t desc;
+	uint64_t cont_hint = 0U;
 
 	unsigned int table_idx;
 
@@ -596,6 +754,13 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 
 		table_idx_pa = mm->base_pa + table_idx_va - mm->base_va;
 
+#if XLAT_TABLES_CONT_HINT
+		if ((table_idx & (XLAT_CONT_ENTRIES - 1U)) == 0U)
+			cont_hint = xlat_tables_cont_hint(mm, table_idx_va,
+					&table_base[table_idx],
+					table_entries - table_idx, level);
+#endif
+
 		action_t action = xlat_tables_map_region_action(mm,
 			(uint32_t)(desc & DESC_MASK), table_idx_pa,
 			table_idx_va, level);
@@ -604,7 +769,7 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 
 			table_base[table_idx] =
 				xlat_desc(ctx, (uint32_t)mm->attr, table_idx_pa,
-					  level);
+					  level) | cont_hint;
 
 		} else if (action == ACTION_CREATE_NEW_TABLE) {
 			uintptr_t end_va;
@@ -628,8 +793,16 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				XLAT_TABLE_ENTRIES * sizeof(uint64_t));
 #endif
 			if (end_va !=
-				(table_idx_va + XLAT_BLOCK_SIZE(level) - 1U))
+				(table_idx_va + XLAT_BLOCK_SIZE(level) - 1U)) {
+#if PLAT_XLAT_TABLES_DYNAMIC
+				/* Nothing could be mapped in the subtable */
+				if (end_va <= MAX(mm->base_va, table_idx_va))
+					xlat_tables_map_region_undo(ctx,
+						table_base, table_idx,
+						table_idx_va, subtable, true);
+#endif
 				return end_va;
+			}
 
 		} else if (action == ACTION_RECURSE_INTO_TABLE) {
 			uintptr_t end_va;
@@ -644,8 +817,16 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				XLAT_TABLE_ENTRIES * sizeof(uint64_t));
 #endif
 			if (end_va !=
-				(table_idx_va + XLAT_BLOCK_SIZE(level) - 1U))
+				(table_idx_va + XLAT_BLOCK_SIZE(level) - 1U)) {
+#if PLAT_XLAT_TABLES_DYNAMIC
+				/* Nothing could be mapped in the subtable */
+				if (end_va <= MAX(mm->base_va, table_idx_va))
+					xlat_tables_map_region_undo(ctx,
+						table_base, table_idx,
+						table_idx_va, subtable, false);
+#endif
 				return end_va;
+			}
 
 		} else {
 
@@ -912,12 +1093,31 @@ static void mmap_alloc_va_align_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 	 */
 	for (unsigned int level = ctx->base_level; level <= 2U; ++level) {
 
+#if XLAT_TABLES_CONT_HINT
+		/*
+		 * Prefer a VA that lets the blocks of this level be grouped
+		 * under a Contiguous hint.
+		 */
+		if ((level >= MIN_LVL_BLOCK_DESC) &&
+		    ((align_check & XLAT_CONT_MASK(level)) == 0U)) {
+			mm->base_va = round_up(mm->base_va,
+					(uintptr_t)XLAT_CONT_SIZE(level));
+			return;
+		}
+#endif
 		if ((align_check & XLAT_BLOCK_MASK(level)) != 0U)
 			continue;
 
 		mm->base_va = round_up(mm->base_va, XLAT_BLOCK_SIZE(level));
 		return;
 	}
+
+#if XLAT_TABLES_CONT_HINT
+	if ((align_check & XLAT_CONT_MASK(XLAT_TABLE_LEVEL_MAX)) == 0U) {
+		mm->base_va = round_up(mm->base_va,
+			(uintptr_t)XLAT_CONT_SIZE(XLAT_TABLE_LEVEL_MAX));
+	}
+#endif
 }
 
 void mmap_add_region_alloc_va_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
@@ -1027,13 +1227,17 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 					.size = end_va - mm->base_va,
 					.attr = 0U
 			};
+			xlat_tlbi_batch_t batch;
+
+			xlat_tlbi_batch_init(&batch, ctx->xlat_regime);
 			xlat_tables_unmap_region(ctx, &unmap_mm, 0U,
 				ctx->base_table, ctx->base_table_entries,
-				ctx->base_level);
+				ctx->base_level, &batch);
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
 			xlat_clean_dcache_range((uintptr_t)ctx->base_table,
 				ctx->base_table_entries * sizeof(uint64_t));
 #endif
+			xlat_arch_tlbi_batch_flush(&batch);
 			return -ENOMEM;
 		}
 
@@ -1113,14 +1317,22 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 
 	/* Update the translation tables if needed */
 	if (ctx->initialized) {
+		xlat_tlbi_batch_t batch;
+
+		xlat_tlbi_batch_init(&batch, ctx->xlat_regime);
 		xlat_tables_unmap_region(ctx, mm, 0U, ctx->base_table,
 					 ctx->base_table_entries,
-					 ctx->base_level);
+					 ctx->base_level, &batch);
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
 		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
 			ctx->base_table_entries * sizeof(uint64_t));
 #endif
-		xlat_arch_tlbi_va_sync();
+		/*
+		 * The TLB invalidations are issued once all the tables have
+		 * been cleaned to memory, so that a table walk after them
+		 * can't find any of the old descriptors.
+		 */
+		xlat_arch_tlbi_batch_flush(&batch);
 	}
 
 	/* Remove this region by moving the rest down by one place. */
@@ -1174,6 +1386,9 @@ void xlat_setup_dynamic_ctx(xlat_ctx_t *ctx, unsigned long long pa_max,
 	ctx->base_table_entries = GET_NUM_BASE_LEVEL_ENTRIES(va_space_size);
 
 	ctx->tables_mapped_regions = mapped_regions;
+	ctx->next_table = 0;
+	ctx->free_tables = NULL;
+	ctx->lookup_cache = NULL;
 
 	ctx->max_pa = 0;
 	ctx->max_va = 0;
@@ -1200,18 +1415,17 @@ void __init init_xlat_tables_ctx(xlat_ctx_t *ctx)
 
 	xlat_mmap_print(mm);
 
-	/* All tables must be zeroed before mapping any region. */
-
+	/*
+	 * The base table must be zeroed before mapping any region. Subtables
+	 * are zeroed as they get allocated.
+	 */
 	for (unsigned int i = 0U; i < ctx->base_table_entries; i++)
 		ctx->base_table[i] = INVALID_DESC;
 
-	for (int j = 0; j < ctx->tables_num; j++) {
 #if PLAT_XLAT_TABLES_DYNAMIC
+	for (int j = 0; j < ctx->tables_num; j++)
 		ctx->tables_mapped_regions[j] = 0;
 #endif
-		for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++)
-			ctx->tables[j][i] = INVALID_DESC;
-	}
 
 	while (mm->size != 0U) {
 		uintptr_t end_va = xlat_tables_map_region(ctx, mm, 0U,
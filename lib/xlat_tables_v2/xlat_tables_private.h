@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -65,6 +65,42 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime);
  */
 void xlat_arch_tlbi_va_sync(void);
 
+/*
+ * Number of TLB invalidations by VA that a batch records. When more entries are
+ * added to the batch, the whole VA range that it covers is invalidated instead.
+ */
+#define XLAT_TLBI_BATCH_SIZE	U(16)
+
+/*
+ * Batch of TLB invalidations, filled while translation table entries are being
+ * modified so that all the invalidations of an operation can be issued at once
+ * and completed with a single DSB.
+ */
+typedef struct xlat_tlbi_batch {
+	int xlat_regime;
+	/* Number of entries added to the batch, may exceed the size of va[] */
+	unsigned int num_va;
+	uintptr_t va[XLAT_TLBI_BATCH_SIZE];
+	/* Lowest and highest VAs translated by the entries of the batch */
+	uintptr_t min_va;
+	uintptr_t max_va;
+} xlat_tlbi_batch_t;
+
+void xlat_tlbi_batch_init(xlat_tlbi_batch_t *batch, int xlat_regime);
+
+/*
+ * Records the invalidation of the TLB entries for the block or page descriptor
+ * that translates 'size' bytes from 'va'.
+ */
+void xlat_tlbi_batch_add(xlat_tlbi_batch_t *batch, uintptr_t va, size_t size);
+
+/*
+ * Issues the invalidations recorded in the batch and waits for them to be
+ * complete. Depending on the number of entries and on the features of the PE,
+ * this uses TLBI by VA, TLBI by range or invalidates the whole regime.
+ */
+void xlat_arch_tlbi_batch_flush(const xlat_tlbi_batch_t *batch);
+
 /* Print VA, PA, size and attributes of all regions in the mmap array. */
 void xlat_mmap_print(const mmap_region_t *mmap);
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -20,7 +20,7 @@
 
 #include "xlat_tables_private.h"
 
-#if LOG_LEVEL < LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE < LOG_LEVEL_VERBOSE
 
 void xlat_mmap_print(__unused const mmap_region_t *mmap)
 {
@@ -32,7 +32,7 @@ void xlat_tables_print(__unused xlat_ctx_t *ctx)
 	/* Empty */
 }
 
-#else /* if LOG_LEVEL >= LOG_LEVEL_VERBOSE */
+#else /* if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE */
 
 void xlat_mmap_print(const mmap_region_t *mmap)
 {
@@ -53,20 +53,23 @@ static void xlat_desc_print(const xlat_ctx_t *ctx, uint64_t desc)
 {
 	uint64_t mem_type_index = ATTR_INDEX_GET(desc);
 	int xlat_regime = ctx->xlat_regime;
+	const char *mem_type;
+	const char *xn;
+	const char *user = "";
+	const char *gp = "";
 
 	if (mem_type_index == ATTR_IWBWA_OWBWA_NTR_INDEX) {
-		printf("MEM");
+		mem_type = "MEM";
 	} else if (mem_type_index == ATTR_NON_CACHEABLE_INDEX) {
-		printf("NC");
+		mem_type = "NC";
 	} else {
 		assert(mem_type_index == ATTR_DEVICE_INDEX);
-		printf("DEV");
+		mem_type = "DEV";
 	}
 
 	if ((xlat_regime == EL3_REGIME) || (xlat_regime == EL2_REGIME)) {
 		/* For EL3 and EL2 only check the AP[2] and XN bits. */
-		printf(((desc & LOWER_ATTRS(AP_RO)) != 0ULL) ? "-RO" : "-RW");
-		printf(((desc & UPPER_ATTRS(XN)) != 0ULL) ? "-XN" : "-EXEC");
+		xn = ((desc & UPPER_ATTRS(XN)) != 0ULL) ? "-XN" : "-EXEC";
 	} else {
 		assert(xlat_regime == EL1_EL0_REGIME);
 		/*
@@ -84,25 +87,29 @@ static void xlat_desc_print(const xlat_ctx_t *ctx, uint64_t desc)
 
 		assert((xn_perm == xn_mask) || (xn_perm == 0ULL));
 #endif
-		printf(((desc & LOWER_ATTRS(AP_RO)) != 0ULL) ? "-RO" : "-RW");
 		/* Only check one of PXN and UXN, the other one is the same. */
-		printf(((desc & UPPER_ATTRS(PXN)) != 0ULL) ? "-XN" : "-EXEC");
+		xn = ((desc & UPPER_ATTRS(PXN)) != 0ULL) ? "-XN" : "-EXEC";
 		/*
 		 * Privileged regions can only be accessed from EL1, user
 		 * regions can be accessed from EL1 and EL0.
 		 */
-		printf(((desc & LOWER_ATTRS(AP_ACCESS_UNPRIVILEGED)) != 0ULL)
-			  ? "-USER" : "-PRIV");
+		user = ((desc & LOWER_ATTRS(AP_ACCESS_UNPRIVILEGED)) != 0ULL)
+			  ? "-USER" : "-PRIV";
 	}
 
-	printf(((LOWER_ATTRS(NS) & desc) != 0ULL) ? "-NS" : "-S");
-
 #ifdef __aarch64__
 	/* Check Guarded Page bit */
 	if ((desc & GP) != 0ULL) {
-		printf("-GP");
+		gp = "-GP";
 	}
 #endif
+
+	printf("%s%s%s%s%s%s%s", mem_type,
+	       ((desc & LOWER_ATTRS(AP_RO)) != 0ULL) ? "-RO" : "-RW",
+	       xn, user,
+	       ((LOWER_ATTRS(NS) & desc) != 0ULL) ? "-NS" : "-S",
+	       gp,
+	       ((desc & UPPER_ATTRS(CONT_HINT)) != 0ULL) ? "-CONT" : "");
 }
 
 static const char * const level_spacers[] = {
@@ -205,7 +212,7 @@ static void xlat_tables_print_internal(xlat_ctx_t *ctx, uintptr_t table_base_va,
 void xlat_tables_print(xlat_ctx_t *ctx)
 {
 	const char *xlat_regime_str;
-	int used_page_tables;
+	unsigned int used, max_used, total;
 
 	if (ctx->xlat_regime == EL1_EL0_REGIME) {
 		xlat_regime_str = "1&0";
@@ -226,24 +233,15 @@ void xlat_tables_print(xlat_ctx_t *ctx)
 	VERBOSE("  Entries @initial lookup level: %u\n",
 		ctx->base_table_entries);
 
-#if PLAT_XLAT_TABLES_DYNAMIC
-	used_page_tables = 0;
-	for (int i = 0; i < ctx->tables_num; ++i) {
-		if (ctx->tables_mapped_regions[i] != 0)
-			++used_page_tables;
-	}
-#else
-	used_page_tables = ctx->next_table;
-#endif
-	VERBOSE("  Used %d sub-tables out of %d (spare: %d)\n",
-		used_page_tables, ctx->tables_num,
-		ctx->tables_num - used_page_tables);
+	xlat_get_tables_usage_ctx(ctx, &used, &max_used, &total);
+	VERBOSE("  Used %u sub-tables out of %u (spare: %u, max used: %u)\n",
+		used, total, total - used, max_used);
 
 	xlat_tables_print_internal(ctx, 0U, ctx->base_table,
 				   ctx->base_table_entries, ctx->base_level);
 }
 
-#endif /* LOG_LEVEL >= LOG_LEVEL_VERBOSE */
+#endif /* LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE */
 
 /*
  * Do a translation table walk to find the block or page descriptor that maps
@@ -324,6 +322,93 @@ static uint64_t *find_xlat_table_entry(uintptr_t virtual_addr,
 	return NULL;
 }
 
+/*
+ * The lookup cache of a context holds, in a single word so that it is always
+ * read and written atomically, the last table below the base level in which a
+ * lookup ended:
+ *   - bits [20:5]: index of the table in ctx->tables
+ *   - bits [2:1]: lookup level of the table
+ *   - bit 0: set if the cache is valid
+ * The upper bits hold the first VA translated by the table, which is aligned
+ * to at least XLAT_BLOCK_SIZE(2).
+ *
+ * Only the tables are cached, not their entries, so changing descriptors in
+ * place doesn't require any maintenance. A table can only go away when it is
+ * released, which invalidates the cache.
+ */
+#define XLAT_LOOKUP_VALID		U(1)
+#define XLAT_LOOKUP_LEVEL_SHIFT		U(1)
+#define XLAT_LOOKUP_LEVEL_MASK		U(0x3)
+#define XLAT_LOOKUP_INDEX_SHIFT		U(5)
+#define XLAT_LOOKUP_INDEX_MASK		U(0xffff)
+
+/*
+ * Same as find_xlat_table_entry(), but starts from the cached table of the
+ * context when it translates the given VA, and updates the cache otherwise.
+ */
+static uint64_t *xlat_lookup_entry(const xlat_ctx_t *ctx, uintptr_t virtual_addr,
+				   unsigned int *out_level)
+{
+	uintptr_t cached = 0U;
+	uintptr_t table_va, idx;
+	uint64_t *table, *entry;
+	unsigned int level;
+
+	if (ctx->lookup_cache != NULL)
+		cached = *ctx->lookup_cache;
+
+	if ((cached & XLAT_LOOKUP_VALID) != 0U) {
+		level = (unsigned int)(cached >> XLAT_LOOKUP_LEVEL_SHIFT) &
+			XLAT_LOOKUP_LEVEL_MASK;
+		table_va = virtual_addr & XLAT_ADDR_MASK(level - 1U);
+
+		if ((cached & XLAT_ADDR_MASK(level - 1U)) == table_va) {
+			idx = (cached >> XLAT_LOOKUP_INDEX_SHIFT) &
+			      XLAT_LOOKUP_INDEX_MASK;
+			entry = &ctx->tables[idx][XLAT_TABLE_IDX(virtual_addr,
+								 level)];
+
+			/*
+			 * Anything else than a block or page descriptor needs
+			 * the full walk, which handles all the cases.
+			 */
+			if ((*entry & DESC_MASK) ==
+			    ((level == XLAT_TABLE_LEVEL_MAX) ?
+			     PAGE_DESC : BLOCK_DESC)) {
+				*out_level = level;
+				return entry;
+			}
+		}
+	}
+
+	entry = find_xlat_table_entry(virtual_addr,
+				      ctx->base_table,
+				      ctx->base_table_entries,
+				      (unsigned long long)ctx->va_max_address + 1ULL,
+				      &level);
+	if (entry == NULL)
+		return NULL;
+
+	*out_level = level;
+
+	if ((ctx->lookup_cache != NULL) && (level > ctx->base_level)) {
+		table = entry - XLAT_TABLE_IDX(virtual_addr, level);
+		idx = ((uintptr_t)table - (uintptr_t)ctx->tables) /
+		      XLAT_TABLE_SIZE;
+		assert(idx < (uintptr_t)ctx->tables_num);
+
+		if (idx <= XLAT_LOOKUP_INDEX_MASK) {
+			*ctx->lookup_cache =
+				(virtual_addr & XLAT_ADDR_MASK(level - 1U)) |
+				(idx << XLAT_LOOKUP_INDEX_SHIFT) |
+				((uintptr_t)level << XLAT_LOOKUP_LEVEL_SHIFT) |
+				XLAT_LOOKUP_VALID;
+		}
+	}
+
+	return entry;
+}
+
 
 static int xlat_get_mem_attributes_internal(const xlat_ctx_t *ctx,
 		uintptr_t base_va, uint32_t *attributes, uint64_t **table_entry,
@@ -332,7 +417,6 @@ static int xlat_get_mem_attributes_internal(const xlat_ctx_t *ctx,
 	uint64_t *entry;
 	uint64_t desc;
 	unsigned int level;
-	unsigned long long virt_addr_space_size;
 
 	/*
 	 * Sanity-check arguments.
@@ -342,15 +426,9 @@ static int xlat_get_mem_attributes_internal(const xlat_ctx_t *ctx,
 	assert((ctx->xlat_regime == EL1_EL0_REGIME) ||
 	       (ctx->xlat_regime == EL2_REGIME) ||
 	       (ctx->xlat_regime == EL3_REGIME));
+	assert(((unsigned long long)ctx->va_max_address + 1ULL) > 0U);
 
-	virt_addr_space_size = (unsigned long long)ctx->va_max_address + 1ULL;
-	assert(virt_addr_space_size > 0U);
-
-	entry = find_xlat_table_entry(base_va,
-				ctx->base_table,
-				ctx->base_table_entries,
-				virt_addr_space_size,
-				&level);
+	entry = xlat_lookup_entry(ctx, base_va, &level);
 	if (entry == NULL) {
 		WARN("Address 0x%lx is not mapped.\n", base_va);
 		return -EINVAL;
@@ -370,11 +448,11 @@ static int xlat_get_mem_attributes_internal(const xlat_ctx_t *ctx,
 
 	desc = *entry;
 
-#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE
 	VERBOSE("Attributes: ");
 	xlat_desc_print(ctx, desc);
 	printf("\n");
-#endif /* LOG_LEVEL >= LOG_LEVEL_VERBOSE */
+#endif /* LOG_LEVEL_THIS_FILE >= LOG_LEVEL_VERBOSE */
 
 	assert(attributes != NULL);
 	*attributes = 0U;
@@ -426,6 +504,175 @@ int xlat_get_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 				NULL, NULL, NULL);
 }
 
+void xlat_get_tables_usage_ctx(const xlat_ctx_t *ctx, unsigned int *used,
+			       unsigned int *max_used, unsigned int *total)
+{
+	assert(ctx != NULL);
+
+	/*
+	 * Tables are only allocated from the ones that have never been used
+	 * when no released table is available, so next_table is also the
+	 * maximum number of tables used at the same time.
+	 */
+	*max_used = (unsigned int)ctx->next_table;
+	*total = (unsigned int)ctx->tables_num;
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+	*used = 0U;
+	for (int i = 0; i < ctx->next_table; i++) {
+		if (ctx->tables_mapped_regions[i] != 0)
+			(*used)++;
+	}
+#else
+	*used = (unsigned int)ctx->next_table;
+#endif
+}
+
+
+#if XLAT_TABLES_CONT_HINT
+/*
+ * Clears the Contiguous hint of the run of pages that contains the page mapped
+ * by the given entry, so that the page can be modified on its own. The whole
+ * run goes through a break-before-make sequence, which means that all of it is
+ * unmapped for a short time. This is only done in translation regimes other
+ * than the current one, whose pages can't be in use by this code, or with the
+ * MMU off, as done by xlat_make_tables_readonly().
+ */
+static void xlat_clear_cont_hint(const xlat_ctx_t *ctx, uintptr_t base_va,
+				 uint64_t *entry)
+{
+	unsigned int run_idx = (unsigned int)(base_va >> PAGE_SIZE_SHIFT) &
+			       (XLAT_CONT_ENTRIES - 1U);
+	uintptr_t run_va = base_va - (run_idx * PAGE_SIZE);
+	uint64_t *run = entry - run_idx;
+	uint64_t desc[XLAT_CONT_ENTRIES];
+	unsigned int i;
+
+	assert(((unsigned int)ctx->xlat_regime != xlat_arch_current_el()) ||
+	       !is_mmu_enabled_ctx(ctx));
+
+	for (i = 0U; i < XLAT_CONT_ENTRIES; i++) {
+		desc[i] = run[i] & ~UPPER_ATTRS(CONT_HINT);
+		run[i] = INVALID_DESC;
+	}
+#if !HW_ASSISTED_COHERENCY
+	clean_dcache_range((uintptr_t)run, XLAT_CONT_ENTRIES * sizeof(uint64_t));
+#endif
+
+	for (i = 0U; i < XLAT_CONT_ENTRIES; i++)
+		xlat_arch_tlbi_va(run_va + (i * PAGE_SIZE), ctx->xlat_regime);
+
+	/* Ensure completion of the invalidation. */
+	xlat_arch_tlbi_va_sync();
+
+	for (i = 0U; i < XLAT_CONT_ENTRIES; i++)
+		run[i] = desc[i];
+#if !HW_ASSISTED_COHERENCY
+	clean_dcache_range((uintptr_t)run, XLAT_CONT_ENTRIES * sizeof(uint64_t));
+#endif
+}
+#endif /* XLAT_TABLES_CONT_HINT */
+
+/*
+ * Returns the descriptor that the page at the given VA gets once the attributes
+ * in 'attr' are applied to it, as well as a pointer to its table entry.
+ */
+static uint64_t xlat_new_page_desc(const xlat_ctx_t *ctx, uintptr_t base_va,
+				   uint32_t attr, uint64_t **entry)
+{
+	uint32_t old_attr = 0U, new_attr;
+	unsigned int level = 0U;
+	unsigned long long addr_pa = 0ULL;
+
+	(void) xlat_get_mem_attributes_internal(ctx, base_va, &old_attr,
+				    entry, &addr_pa, &level);
+
+#if XLAT_TABLES_CONT_HINT
+	/*
+	 * The descriptors of a contiguous run must all agree, so split the run
+	 * before changing any of its pages.
+	 */
+	if ((**entry & UPPER_ATTRS(CONT_HINT)) != 0U)
+		xlat_clear_cont_hint(ctx, base_va, *entry);
+#endif
+
+	/*
+	 * From attr, only MT_RO/MT_RW, MT_EXECUTE/MT_EXECUTE_NEVER and
+	 * MT_USER/MT_PRIVILEGED are taken into account. Any other information
+	 * is ignored.
+	 */
+
+	/* Clean the old attributes so that they can be rebuilt. */
+	new_attr = old_attr & ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
+
+	/*
+	 * Update attributes, but filter out the ones this function isn't
+	 * allowed to change.
+	 */
+	new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+
+	return xlat_desc(ctx, new_attr, addr_pa, level);
+}
+
+/*
+ * Changes the attributes of 'pages_count' pages from 'base_va', which must all
+ * be mapped with page descriptors, one level 3 table at a time. The pages of a
+ * table go through the break-before-make sequence together, so that their TLB
+ * invalidations can be batched and completed with a single DSB.
+ */
+static void xlat_change_pages_attributes(const xlat_ctx_t *ctx,
+					 uintptr_t base_va, size_t pages_count,
+					 uint32_t attr)
+{
+	xlat_tlbi_batch_t batch;
+	uint64_t *table = NULL;
+	uint64_t *entry;
+	size_t n, i;
+
+	while (pages_count > 0U) {
+		/* Number of pages left in the current table */
+		n = XLAT_TABLE_ENTRIES -
+		    XLAT_TABLE_IDX(base_va, XLAT_TABLE_LEVEL_MAX);
+		if (n > pages_count)
+			n = pages_count;
+
+		xlat_tlbi_batch_init(&batch, ctx->xlat_regime);
+
+		for (i = 0U; i < n; i++) {
+			uintptr_t va = base_va + (i * PAGE_SIZE);
+			uint64_t desc = xlat_new_page_desc(ctx, va, attr,
+							   &entry);
+
+			if (i == 0U)
+				table = entry;
+			assert(entry == &table[i]);
+
+			/*
+			 * Keep the new descriptor in the entry until the
+			 * invalidations are complete, with the type bits
+			 * cleared so that the MMU treats it as invalid.
+			 */
+			*entry = desc & ~(uint64_t)DESC_MASK;
+			xlat_tlbi_batch_add(&batch, va, PAGE_SIZE);
+		}
+#if !HW_ASSISTED_COHERENCY
+		clean_dcache_range((uintptr_t)table, n * sizeof(uint64_t));
+#endif
+		xlat_arch_tlbi_batch_flush(&batch);
+
+		for (i = 0U; i < n; i++)
+			table[i] |= PAGE_DESC;
+#if !HW_ASSISTED_COHERENCY
+		clean_dcache_range((uintptr_t)table, n * sizeof(uint64_t));
+#endif
+
+		base_va += n * PAGE_SIZE;
+		pages_count -= n;
+	}
+
+	/* Ensure that the last descriptor written is seen by the system. */
+	dsbish();
+}
 
 int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 				   size_t size, uint32_t attr)
@@ -435,9 +682,7 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 	assert(ctx != NULL);
 	assert(ctx->initialized);
 
-	unsigned long long virt_addr_space_size =
-		(unsigned long long)ctx->va_max_address + 1U;
-	assert(virt_addr_space_size > 0U);
+	assert(((unsigned long long)ctx->va_max_address + 1U) > 0U);
 
 	if (!IS_PAGE_ALIGNED(base_va)) {
 		WARN("%s: Address 0x%lx is not aligned on a page boundary.\n",
@@ -477,11 +722,7 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 		uint64_t desc, attr_index;
 		unsigned int level;
 
-		entry = find_xlat_table_entry(base_va,
-					      ctx->base_table,
-					      ctx->base_table_entries,
-					      virt_addr_space_size,
-					      &level);
+		entry = xlat_lookup_entry(ctx, base_va, &level);
 		if (entry == NULL) {
 			WARN("Address 0x%lx is not mapped.\n", base_va);
 			return -EINVAL;
@@ -502,6 +743,22 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 			return -EINVAL;
 		}
 
+#if XLAT_TABLES_CONT_HINT
+		/*
+		 * Changing a page of a contiguous run unmaps the whole run for
+		 * a while. In the current translation regime, this may include
+		 * the code, stack or data in use by this function, so refuse
+		 * to split the run unless the MMU is off.
+		 */
+		if (((desc & UPPER_ATTRS(CONT_HINT)) != 0U) &&
+		    ((unsigned int)ctx->xlat_regime == xlat_arch_current_el()) &&
+		    is_mmu_enabled_ctx(ctx)) {
+			WARN("Address 0x%lx is mapped with the Contiguous hint.\n",
+			     base_va);
+			return -EINVAL;
+		}
+#endif
+
 		/*
 		 * If the region type is device, it shouldn't be executable.
 		 */
@@ -520,30 +777,21 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 	/* Restore original value. */
 	base_va = base_va_original;
 
-	for (unsigned int i = 0U; i < pages_count; ++i) {
+	/*
+	 * If the translation regime isn't the one of the caller, none of the
+	 * pages can be in use by this code, so all the pages of a table can be
+	 * unmapped at the same time and share the TLB maintenance.
+	 */
+	if ((unsigned int)ctx->xlat_regime != xlat_arch_current_el()) {
+		xlat_change_pages_attributes(ctx, base_va, pages_count, attr);
+		return 0;
+	}
 
-		uint32_t old_attr = 0U, new_attr;
+	for (unsigned int i = 0U; i < pages_count; ++i) {
 		uint64_t *entry = NULL;
-		unsigned int level = 0U;
-		unsigned long long addr_pa = 0ULL;
+		uint64_t desc;
 
-		(void) xlat_get_mem_attributes_internal(ctx, base_va, &old_attr,
-					    &entry, &addr_pa, &level);
-
-		/*
-		 * From attr, only MT_RO/MT_RW, MT_EXECUTE/MT_EXECUTE_NEVER and
-		 * MT_USER/MT_PRIVILEGED are taken into account. Any other
-		 * information is ignored.
-		 */
-
-		/* Clean the old attributes so that they can be rebuilt. */
-		new_attr = old_attr & ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
-
-		/*
-		 * Update attributes, but filter out the ones this function
-		 * isn't allowed to change.
-		 */
-		new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+		desc = xlat_new_page_desc(ctx, base_va, attr, &entry);
 
 		/*
 		 * The break-before-make sequence requires writing an invalid
@@ -561,7 +809,7 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 		xlat_arch_tlbi_va_sync();
 
 		/* Write new descriptor */
-		*entry = xlat_desc(ctx, new_attr, addr_pa, level);
+		*entry = desc;
 #if !HW_ASSISTED_COHERENCY
 		dccvac((uintptr_t)entry);
 #endif
@@ -26,6 +26,9 @@ ARM_ARCH_FEATURE		:= none
 ARM_ARCH_MAJOR			:= 8
 ARM_ARCH_MINOR			:= 0
 
+# Flag to buffer the runtime console output of BL31 in per-CPU rings
+ASYNC_CONSOLE			:= 0
+
 # Base commit to perform code check on
 BASE_COMMIT			:= origin/master
 
@@ -39,6 +42,10 @@ BL2_IN_XIP_MEM			:= 0
 # Do dcache invalidate upon BL2 entry at EL3
 BL2_INV_DCACHE			:= 1
 
+# Record the duration of the cold boot steps of each image and print them from
+# BL31, see tools/bootprof/bootprof.py
+BOOT_PROFILING			:= 0
+
 # Select the branch protection features to use.
 BRANCH_PROTECTION		:= 0
 
@@ -50,6 +57,9 @@ COLD_BOOT_SINGLE_CPU		:= 0
 # Makefile system will set this when compiling TF as part of a coreboot image.
 COREBOOT			:= 0
 
+# Flag to save the state of a crashing CPU to a reserved memory region in BL31
+CRASH_DUMP_MEM			:= 0
+
 # For Chain of Trust
 CREATE_KEYS			:= 1
 
@@ -90,6 +100,9 @@ DISABLE_MTPMU			:= 0
 # development platforms.
 DYN_DISABLE_AUTH		:= 0
 
+# Flag to record lock contention statistics per lock call site in BL31
+ENABLE_LOCK_PROFILING		:= 0
+
 # Build option to enable MPAM for lower ELs
 ENABLE_MPAM_FOR_LOWER_ELS	:= 0
 
@@ -111,6 +124,10 @@ ENABLE_STACK_PROTECTOR		:= 0
 # Flag to enable exception handling in EL3
 EL3_EXCEPTION_HANDLING		:= 0
 
+# Drop the BL31 handlers for exceptions taken from lower ELs in AArch32, for
+# platforms where no lower EL, including EL0, ever runs in AArch32
+EL3_NO_AARCH32_LOWER_EL		:= 0
+
 # Flag to enable Branch Target Identification.
 # Internal flag not meant for direct setting.
 # Use BRANCH_PROTECTION to enable BTI.
@@ -178,9 +195,18 @@ ifeq ($(KEY_ALG),rsa)
 KEY_SIZE			:= 2048
 endif
 
+# Flag to record the log messages of BL31 in binary form instead of printing them
+LOG_BINARY			:= 0
+
+# Per-module log levels, as a list of <path>:<log level>
+LOG_LEVEL_MODULES		:=
+
 # Option to build TF with Measured Boot support
 MEASURED_BOOT			:= 0
 
+# Per-CPU non-secure shared buffers registered through a vendor-specific SMC
+NS_SHARED_BUF_SUPPORT		:= 0
+
 # NS timer register save and restore
 NS_TIMER_SWITCH			:= 0
 
@@ -209,6 +235,9 @@ SAVE_KEYS			:= 0
 # Software Delegated Exception support
 SDEI_SUPPORT            	:= 0
 
+# Batched dispatch of fast SMCs through the per-CPU Non-secure shared buffer
+SMC_MULTICALL_SUPPORT		:= 0
+
 # True Random Number firmware Interface
 TRNG_SUPPORT            	:= 0
 
@@ -280,6 +309,10 @@ V				:= 0
 # platforms).
 WARMBOOT_ENABLE_DCACHE_EARLY	:= 0
 
+# Build option to set the Contiguous hint on runs of adjacent block or page
+# descriptors mapped by the translation tables library v2.
+XLAT_TABLES_CONT_HINT		:= 0
+
 # Build option to enable/disable the Statistical Profiling Extensions
 ENABLE_SPE_FOR_LOWER_ELS	:= 1
 
@@ -312,6 +345,16 @@ SANITIZE_UB := off
 # Default: disabled
 USE_SPINLOCK_CAS := 0
 
+# Enabling this option keeps an acquisition count and the time spent waiting
+# in each ticket lock.
+# Default: disabled
+TICKET_LOCK_STATS := 0
+
+# Implement bakery locks with ticket locks, which relies on all the CPUs being
+# coherent with their data cache enabled whenever they take a bakery lock.
+# Default: disabled
+USE_ATOMIC_BAKERY_LOCKS := 0
+
 # Enable Link Time Optimization
 ENABLE_LTO			:= 0
 
@@ -61,6 +61,22 @@ BL31_SOURCES		+=	drivers/allwinner/sunxi_msgbox.c	\
 				${AW_PLAT}/common/sunxi_scpi_pm.c
 endif
 
+# Keep a copy of the console output in DRAM, for the OS to read it back. Only
+# supported when BL31 runs from DRAM.
+SUNXI_MEM_LOG		?=	0
+
+$(eval $(call assert_boolean,SUNXI_MEM_LOG))
+$(eval $(call add_define,SUNXI_MEM_LOG))
+
+ifeq (${SUNXI_MEM_LOG},1)
+BL31_SOURCES		+=	drivers/console/mem_log_console.c
+endif
+
+# The Non-secure shared buffers are mapped at runtime.
+ifeq (${NS_SHARED_BUF_SUPPORT},1)
+BL31_CPPFLAGS		+=	-DPLAT_XLAT_TABLES_DYNAMIC
+endif
+
 # The bootloader is guaranteed to only run on CPU 0 by the boot ROM.
 COLD_BOOT_SINGLE_CPU		:=	1
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -18,11 +18,15 @@
 #define BL31_BASE			SUNXI_DRAM_BASE
 #define BL31_LIMIT			(SUNXI_DRAM_BASE + 0x40000)
 
-#define MAX_XLAT_TABLES			4
+#define MAX_XLAT_TABLES			(4 + SUNXI_NS_BUF_COUNT)
 #define PLAT_VIRT_ADDR_SPACE_SIZE	(1ULL << 32)
 
 #define SUNXI_BL33_VIRT_BASE		PRELOADED_BL33_BASE
 
+/* The memory log follows BL31, and is reserved in the DT handed to BL33. */
+#define SUNXI_MEM_LOG_BASE		BL31_LIMIT
+#define SUNXI_MEM_LOG_SIZE		0x10000
+
 #else	/* !SUNXI_BL31_IN_DRAM */
 
 #define BL31_BASE			(SUNXI_SRAM_A2_BASE + 0x4000)
@@ -42,6 +46,10 @@
 #define SUNXI_SCP_BASE			BL31_LIMIT
 #define SUNXI_SCP_SIZE			0x4000
 
+#if SUNXI_MEM_LOG
+#error "SUNXI_MEM_LOG is only supported with BL31 in DRAM"
+#endif
+
 #endif /* SUNXI_BL31_IN_DRAM */
 
 /* How much DRAM to map (to map BL33, for fetching the DTB from U-Boot) */
@@ -50,8 +58,19 @@
 #define CACHE_WRITEBACK_SHIFT		6
 #define CACHE_WRITEBACK_GRANULE		(1 << CACHE_WRITEBACK_SHIFT)
 
-#define MAX_STATIC_MMAP_REGIONS		3
-#define MAX_MMAP_REGIONS		(5 + MAX_STATIC_MMAP_REGIONS)
+/*
+ * Each CPU may map a Non-secure shared buffer at runtime, which takes a region
+ * and, when BL31 is in DRAM, a translation table.
+ */
+#if NS_SHARED_BUF_SUPPORT
+#define SUNXI_NS_BUF_COUNT		PLATFORM_CORE_COUNT
+#else
+#define SUNXI_NS_BUF_COUNT		0
+#endif
+
+#define MAX_STATIC_MMAP_REGIONS		4
+#define MAX_MMAP_REGIONS		(5 + MAX_STATIC_MMAP_REGIONS + \
+					 SUNXI_NS_BUF_COUNT)
 
 #define PLAT_CSS_SCP_COM_SHARED_MEM_BASE \
 	(SUNXI_SRAM_A2_BASE + SUNXI_SRAM_A2_SIZE - 0x200)
@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stdbool.h>
 
 #include <libfdt.h>
 
@@ -18,6 +19,7 @@
 #include <drivers/arm/gicv2.h>
 #include <drivers/console.h>
 #include <drivers/generic_delay_timer.h>
+#include <drivers/mem_log_console.h>
 #include <drivers/ti/uart/uart_16550.h>
 #include <lib/mmio.h>
 #include <plat/common/platform.h>
@@ -30,7 +32,17 @@
 static entry_point_info_t bl32_image_ep_info;
 static entry_point_info_t bl33_image_ep_info;
 
-static console_t console;
+static console_16550_t boot_console;
+static console_t runtime_console;
+#if SUNXI_MEM_LOG
+static console_mem_log_t mem_log_console;
+#endif
+
+#if NS_SHARED_BUF_SUPPORT
+/* DRAM described by the DTB, empty when there isn't any */
+static unsigned long long sunxi_dram_base;
+static unsigned long long sunxi_dram_size;
+#endif
 
 static const gicv2_driver_data_t sunxi_gic_data = {
 	.gicd_base = SUNXI_GICD_BASE,
@@ -78,14 +90,59 @@ static void *sunxi_find_dtb(void)
 	return NULL;
 }
 
+#if NS_SHARED_BUF_SUPPORT
+/*
+ * Read the first range of the memory node of the DTB. The size of the DRAM is
+ * only known to U-Boot, and accesses beyond it wrap around to its start.
+ */
+static void sunxi_find_dram(const void *fdt)
+{
+	const fdt32_t *reg;
+	int node, addr_cells, size_cells, len, i;
+
+	if (fdt == NULL)
+		return;
+
+	node = fdt_node_offset_by_prop_value(fdt, -1, "device_type",
+					     "memory", sizeof("memory"));
+	if (node < 0)
+		return;
+
+	addr_cells = fdt_address_cells(fdt, 0);
+	size_cells = fdt_size_cells(fdt, 0);
+	reg = fdt_getprop(fdt, node, "reg", &len);
+	if ((reg == NULL) || (addr_cells < 1) || (addr_cells > 2) ||
+	    (size_cells < 1) || (size_cells > 2) ||
+	    (len < (int)((addr_cells + size_cells) * sizeof(*reg))))
+		return;
+
+	for (i = 0; i < addr_cells; i++)
+		sunxi_dram_base = (sunxi_dram_base << 32) |
+				  fdt32_to_cpu(reg[i]);
+	for (i = 0; i < size_cells; i++)
+		sunxi_dram_size = (sunxi_dram_size << 32) |
+				  fdt32_to_cpu(reg[addr_cells + i]);
+}
+#endif
+
 void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 				u_register_t arg2, u_register_t arg3)
 {
-	/* Initialize the debug console as soon as possible */
-	console_16550_register(SUNXI_UART0_BASE, SUNXI_UART0_CLK_IN_HZ,
-			       SUNXI_UART0_BAUDRATE, &console);
-	console_set_scope(&console,
-			  CONSOLE_FLAG_BOOT |
+	/*
+	 * Initialize the debug console as soon as possible. The cold boot runs
+	 * on a single CPU with the UART to itself, so fill its FIFO in bursts.
+	 */
+	console_16550_fifo_register(SUNXI_UART0_BASE, SUNXI_UART0_CLK_IN_HZ,
+				    SUNXI_UART0_BAUDRATE, SUNXI_UART0_FIFO_SIZE,
+				    &boot_console);
+	console_set_scope(&boot_console.console, CONSOLE_FLAG_BOOT);
+
+	/*
+	 * At runtime the UART is shared with the OS and all the CPUs, so check
+	 * the line status for each character.
+	 */
+	console_16550_register(SUNXI_UART0_BASE, 0, 0, &runtime_console);
+	console_set_scope(&runtime_console,
 			  CONSOLE_FLAG_RUNTIME |
 			  CONSOLE_FLAG_CRASH);
 
@@ -111,6 +168,17 @@ void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 void bl31_plat_arch_setup(void)
 {
 	sunxi_configure_mmu_el3(0);
+
+#if SUNXI_MEM_LOG
+	/* The memory log is only accessible once the MMU maps it. */
+	if (console_mem_log_register(SUNXI_MEM_LOG_BASE, SUNXI_MEM_LOG_SIZE,
+				     &mem_log_console) != 0) {
+		console_set_scope(&mem_log_console.console,
+				  CONSOLE_FLAG_BOOT |
+				  CONSOLE_FLAG_RUNTIME |
+				  CONSOLE_FLAG_CRASH);
+	}
+#endif
 }
 
 void bl31_platform_setup(void)
@@ -153,6 +221,12 @@ void bl31_platform_setup(void)
 		NOTICE("BL31: No DTB found.\n");
 	}
 
+#if NS_SHARED_BUF_SUPPORT
+	sunxi_find_dram(fdt);
+	if (sunxi_dram_size == 0U)
+		WARN("BL31: No DRAM in the DTB, NS shared buffers disabled\n");
+#endif
+
 	exception = mmio_read_32(SUNXI_RTC_BASE + 0x108);
 	if (exception)
 		NOTICE("BL31: Last SCP exception was 0x%08x\n", exception);
@@ -206,3 +280,38 @@ entry_point_info_t *bl31_plat_get_next_image_ep_info(uint32_t type)
 
 	return NULL;
 }
+
+#if NS_SHARED_BUF_SUPPORT
+static bool sunxi_ns_buf_overlaps(unsigned long long pa, size_t size,
+				  unsigned long long base,
+				  unsigned long long limit)
+{
+	return (pa < limit) && ((pa + size) > base);
+}
+
+/*
+ * Only accept Non-secure shared buffers lying entirely in the DRAM described by
+ * the DTB, outside of the memory used by the secure images.
+ */
+int plat_ns_buf_validate(unsigned long long pa, size_t size)
+{
+	if ((pa < sunxi_dram_base) || (size > sunxi_dram_size) ||
+	    ((pa - sunxi_dram_base) > (sunxi_dram_size - size)))
+		return -1;
+
+#ifdef SUNXI_BL31_IN_DRAM
+	/* BL31, followed by the memory log */
+	if (sunxi_ns_buf_overlaps(pa, size, BL31_BASE,
+				  SUNXI_MEM_LOG_BASE + SUNXI_MEM_LOG_SIZE))
+		return -1;
+#endif
+
+#ifndef SPD_none
+	/* BL32 is loaded by U-Boot below BL33, its size isn't known here. */
+	if (sunxi_ns_buf_overlaps(pa, size, BL32_BASE, PRELOADED_BL33_BASE))
+		return -1;
+#endif
+
+	return 0;
+}
+#endif /* NS_SHARED_BUF_SUPPORT */
@@ -4,14 +4,45 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stdio.h>
+
 #include <libfdt.h>
 
 #include <common/debug.h>
 #include <common/fdt_fixup.h>
 #include <common/fdt_wrappers.h>
+#include <drivers/mem_log_console.h>
 
 #include <sunxi_private.h>
 
+#if SUNXI_MEM_LOG
+static int sunxi_add_mem_log_node(void *fdt)
+{
+	char name[32];
+	int offs, ret;
+
+	snprintf(name, sizeof(name), "tf-a-log@%lx",
+		 (unsigned long)SUNXI_MEM_LOG_BASE);
+
+	ret = fdt_add_reserved_memory(fdt, name, SUNXI_MEM_LOG_BASE,
+				      SUNXI_MEM_LOG_SIZE);
+	if (ret != 0) {
+		return ret;
+	}
+
+	offs = fdt_path_offset(fdt, "/reserved-memory");
+	if (offs >= 0) {
+		offs = fdt_subnode_offset(fdt, offs, name);
+	}
+	if (offs < 0) {
+		return offs;
+	}
+
+	return fdt_setprop_string(fdt, offs, "compatible",
+				  MEM_LOG_DT_COMPATIBLE);
+}
+#endif
+
 void sunxi_prepare_dtb(void *fdt)
 {
 	int ret;
@@ -32,6 +63,13 @@ void sunxi_prepare_dtb(void *fdt)
 		return;
 	}
 
+#if SUNXI_MEM_LOG
+	/* Let the OS find the memory log, and keep it from using that memory. */
+	if (sunxi_add_mem_log_node(fdt) != 0) {
+		WARN("Failed to add memory log node to DT.\n");
+	}
+#endif
+
 	ret = fdt_pack(fdt);
 	if (ret < 0) {
 		ERROR("Failed to pack devicetree at %p: error %d\n",
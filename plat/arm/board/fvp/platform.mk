@@ -37,6 +37,14 @@ $(eval $(call add_define,FVP_MAX_PE_PER_CPU))
 # Pass FVP_GICR_REGION_PROTECTION to the build system.
 $(eval $(call add_define,FVP_GICR_REGION_PROTECTION))
 
+# The redistributor frames are made RW at runtime, which can't be done to the
+# pages of a contiguous run.
+ifeq (${FVP_GICR_REGION_PROTECTION}, 1)
+    ifeq (${XLAT_TABLES_CONT_HINT}, 1)
+        $(error "FVP_GICR_REGION_PROTECTION is not supported with XLAT_TABLES_CONT_HINT")
+    endif
+endif
+
 # Sanity check the cluster count and if FVP_CLUSTER_COUNT <= 2,
 # choose the CCI driver , else the CCN driver
 ifeq ($(FVP_CLUSTER_COUNT), 0)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -383,3 +383,28 @@ void __init bl31_plat_arch_setup(void)
 {
 	arm_bl31_plat_arch_setup();
 }
+
+#if NS_SHARED_BUF_SUPPORT
+/*******************************************************************************
+ * Only accept Non-secure shared buffers lying entirely in the Non-secure DRAM.
+ ******************************************************************************/
+static bool arm_ns_buf_in(unsigned long long pa, size_t size,
+			  unsigned long long base, unsigned long long len)
+{
+	return (pa >= base) && (size <= len) && ((pa - base) <= (len - size));
+}
+
+int plat_ns_buf_validate(unsigned long long pa, size_t size)
+{
+	if (arm_ns_buf_in(pa, size, ARM_NS_DRAM1_BASE, ARM_NS_DRAM1_SIZE)) {
+		return 0;
+	}
+#ifdef __aarch64__
+	if (arm_ns_buf_in(pa, size, ARM_DRAM2_BASE, ARM_DRAM2_SIZE)) {
+		return 0;
+	}
+#endif
+
+	return -1;
+}
+#endif /* NS_SHARED_BUF_SUPPORT */
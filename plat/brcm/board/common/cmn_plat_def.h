@@ -10,7 +10,7 @@
 #include <bcm_elog.h>
 
 #ifndef GET_LOG_LEVEL
-#define GET_LOG_LEVEL() LOG_LEVEL
+#define GET_LOG_LEVEL() LOG_LEVEL_THIS_FILE
 #endif
 
 #ifndef SET_LOG_LEVEL
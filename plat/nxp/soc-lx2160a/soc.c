@@ -240,7 +240,7 @@ void soc_early_init(void)
 	gpio_init(&gpio_init_data);
 	sec_init(NXP_CAAM_ADDR);
 #endif
-#if LOG_LEVEL > 0
+#if LOG_LEVEL_THIS_FILE > 0
 	/* Initialize the console to provide early debug support */
 	plat_console_init(NXP_CONSOLE_ADDR,
 				NXP_UART_CLK_DIVIDER, NXP_CONSOLE_BAUDRATE);
@@ -429,7 +429,7 @@ void soc_early_platform_setup2(void)
 	 */
 	delay_timer_init(NXP_TIMER_ADDR);
 
-#if LOG_LEVEL > 0
+#if LOG_LEVEL_THIS_FILE > 0
 	/* Initialize the console to provide early debug support */
 	plat_console_init(NXP_CONSOLE_ADDR,
 			  NXP_UART_CLK_DIVIDER, NXP_CONSOLE_BAUDRATE);
@@ -44,10 +44,10 @@ void *qtiseclib_cb_memmove(void *dest, const void *src, size_t n)
 	return memmove(dest, src, n);
 }
 
-/* Printing logs below or equal LOG_LEVEL from QTISECLIB. */
+/* Printing logs below or equal LOG_LEVEL_THIS_FILE from QTISECLIB. */
 void qtiseclib_cb_log(unsigned int loglvl, const char *fmt, ...)
 {
-	if (loglvl <= LOG_LEVEL) {
+	if (loglvl <= LOG_LEVEL_THIS_FILE) {
 		va_list argp;
 		static spinlock_t qti_log_lock;
 		uint64_t uptime = read_cntpct_el0();
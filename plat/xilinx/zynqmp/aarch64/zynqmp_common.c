@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -53,7 +53,7 @@ unsigned int zynqmp_get_uart_clk(void)
 		return 100000000;
 }
 
-#if LOG_LEVEL >= LOG_LEVEL_NOTICE
+#if LOG_LEVEL_THIS_FILE >= LOG_LEVEL_NOTICE
 static const struct {
 	unsigned int id;
 	unsigned int ver;
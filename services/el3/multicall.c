@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Multicall: dispatch a batch of fast SMCs described in the per-CPU Non-secure
+ * shared buffer in a single entry into EL3.
+ *
+ * Each call is run through handle_runtime_svc() exactly as if the caller had
+ * issued it directly, using the caller's context to pass arguments and collect
+ * results. Only calls known to neither change the power state of the CPU nor
+ * switch to another world are accepted, since those would not return to the
+ * multicall handler.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <bl31/ns_buf.h>
+#include <common/debug.h>
+#include <common/runtime_svc.h>
+#include <context.h>
+#include <lib/el3_runtime/context_mgmt.h>
+#include <lib/psci/psci.h>
+#include <plat/common/platform.h>
+#include <services/arm_arch_svc.h>
+#include <services/multicall_svc.h>
+#include <services/trng_svc.h>
+#include <smccc_helpers.h>
+
+#if !NS_SHARED_BUF_SUPPORT
+#error "SMC_MULTICALL_SUPPORT requires NS_SHARED_BUF_SUPPORT"
+#endif
+
+#pragma weak plat_multicall_fid_allowed
+
+/*
+ * SiP and OEM calls are platform-specific and may not return, or may switch
+ * to another world, so none of them may be batched unless the platform says
+ * otherwise.
+ */
+bool plat_multicall_fid_allowed(uint32_t smc_fid)
+{
+	return false;
+}
+
+static bool is_arm_arch_query_fid(uint32_t smc_fid)
+{
+	switch (smc_fid) {
+	case SMCCC_VERSION:
+	case SMCCC_ARCH_FEATURES:
+	case SMCCC_ARCH_SOC_ID:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool is_psci_query_fid(uint32_t smc_fid)
+{
+	switch (smc_fid) {
+	case PSCI_VERSION:
+	case PSCI_AFFINITY_INFO_AARCH32:
+	case PSCI_AFFINITY_INFO_AARCH64:
+	case PSCI_MIG_INFO_TYPE:
+	case PSCI_MIG_INFO_UP_CPU_AARCH32:
+	case PSCI_MIG_INFO_UP_CPU_AARCH64:
+	case PSCI_FEATURES:
+	case PSCI_NODE_HW_STATE_AARCH32:
+	case PSCI_NODE_HW_STATE_AARCH64:
+	case PSCI_STAT_RESIDENCY_AARCH32:
+	case PSCI_STAT_RESIDENCY_AARCH64:
+	case PSCI_STAT_COUNT_AARCH32:
+	case PSCI_STAT_COUNT_AARCH64:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/*
+ * Return true if 'smc_fid' may be issued from a multicall. Only calls known to
+ * return to the caller without switching to another world are accepted: the
+ * Arm Architecture, PSCI and TRNG query calls, and the SiP and OEM calls which
+ * the platform allows. Anything else, including a nested multicall, is
+ * rejected.
+ */
+static bool multicall_fid_allowed(uint32_t smc_fid)
+{
+	if (GET_SMC_TYPE(smc_fid) != SMC_TYPE_FAST) {
+		return false;
+	}
+
+	switch (GET_SMC_OEN(smc_fid)) {
+	case OEN_ARM_START:
+		return is_arm_arch_query_fid(smc_fid);
+
+	case OEN_SIP_START:
+	case OEN_OEM_START:
+		return plat_multicall_fid_allowed(smc_fid);
+
+	case OEN_STD_START:
+		return is_psci_query_fid(smc_fid) || is_trng_fid(smc_fid);
+
+	default:
+		return false;
+	}
+}
+
+static void multicall_dispatch(multicall_entry_t *entry, void *cookie,
+			       void *handle, u_register_t flags)
+{
+	gp_regs_t *gpregs = get_gpregs_ctx(handle);
+	uint32_t smc_fid = (uint32_t)entry->regs[0];
+	unsigned int i;
+
+	if (!multicall_fid_allowed(smc_fid)) {
+		entry->regs[0] = (uint64_t)SMC_UNK;
+		return;
+	}
+
+	/* Arguments of a 32-bit call are taken from the low half only */
+	if (GET_SMC_CC(smc_fid) == SMC_32) {
+		for (i = 1U; i < ARRAY_SIZE(entry->regs); i++) {
+			entry->regs[i] &= 0xffffffffU;
+		}
+	}
+
+	for (i = 0U; i < ARRAY_SIZE(entry->regs); i++) {
+		write_ctx_reg(gpregs, CTX_GPREG_X0 + (i << 3), entry->regs[i]);
+	}
+
+	(void)handle_runtime_svc(smc_fid, cookie, handle, (unsigned int)flags);
+
+	/*
+	 * None of the allowed calls may switch away from the caller. If one
+	 * did, the context of the caller can't be restored.
+	 */
+	if (cm_get_context(NON_SECURE) != handle) {
+		ERROR("Multicall: call 0x%x switched context\n", smc_fid);
+		panic();
+	}
+
+	for (i = 0U; i < ARRAY_SIZE(entry->regs); i++) {
+		entry->regs[i] = read_ctx_reg(gpregs, CTX_GPREG_X0 + (i << 3));
+	}
+}
+
+/*
+ * x1: offset of the first multicall_entry_t in the shared buffer
+ * x2: number of entries
+ *
+ * Returns the status in x0 and the number of calls dispatched in x1.
+ */
+uintptr_t multicall_smc_handler(uint32_t smc_fid,
+				u_register_t x1,
+				u_register_t x2,
+				u_register_t x3,
+				u_register_t x4,
+				void *cookie,
+				void *handle,
+				u_register_t flags)
+{
+	gp_regs_t saved_gpregs;
+	multicall_entry_t entry;
+	u_register_t i;
+
+	if (is_caller_secure(flags)) {
+		SMC_RET1(handle, MULTICALL_E_DENIED);
+	}
+
+	if ((x2 == 0U) || (x2 > PLAT_MULTICALL_MAX_CALLS) ||
+	    (ns_buf_ptr(x1, x2 * sizeof(entry)) == NULL)) {
+		SMC_RET2(handle, MULTICALL_E_INVALID_PARAMS, 0);
+	}
+
+	/*
+	 * The individual handlers return their results through the caller's
+	 * context. Keep a copy so the caller sees its own registers preserved,
+	 * as required by the SMCCC, once the batch completes.
+	 */
+	saved_gpregs = *get_gpregs_ctx(handle);
+
+	for (i = 0U; i < x2; i++) {
+		size_t offset = x1 + (i * sizeof(entry));
+
+		/*
+		 * Work on a private copy so that the caller cannot change an
+		 * entry after it has been checked.
+		 */
+		(void)ns_buf_read(&entry, offset, sizeof(entry));
+		multicall_dispatch(&entry, cookie, handle, flags);
+		(void)ns_buf_write(offset, &entry, sizeof(entry));
+	}
+
+	*get_gpregs_ctx(handle) = saved_gpregs;
+
+	SMC_RET2(handle, MULTICALL_E_SUCCESS, i);
+}
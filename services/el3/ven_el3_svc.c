@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include <bl31/ns_buf.h>
+#include <common/debug.h>
+#include <common/runtime_svc.h>
+#include <lib/lock_prof.h>
+#include <services/multicall_svc.h>
+#include <services/ven_el3_svc.h>
+#include <smccc_helpers.h>
+#include <tools_share/uuid.h>
+
+/* Vendor-Specific EL3 Monitor Service UUID */
+DEFINE_SVC_UUID2(ven_el3_svc_uid,
+	0xb6011dca, 0x57c4, 0x407e, 0x83, 0xf0,
+	0xa7, 0xed, 0xda, 0xf0, 0xdf, 0x6c);
+
+/*
+ * Top-level Vendor-Specific EL3 Monitor Service SMC handler. This handler
+ * dispatches the calls to the individual EL3 facilities.
+ */
+static uintptr_t ven_el3_svc_handler(uint32_t smc_fid,
+				     u_register_t x1,
+				     u_register_t x2,
+				     u_register_t x3,
+				     u_register_t x4,
+				     void *cookie,
+				     void *handle,
+				     u_register_t flags)
+{
+	unsigned int call_count = 0U;
+
+	if (is_ns_buf_fid(smc_fid)) {
+		return ns_buf_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					  handle, flags);
+	}
+
+	if (is_multicall_fid(smc_fid)) {
+		return multicall_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					     handle, flags);
+	}
+
+	if (is_lock_prof_fid(smc_fid)) {
+		return lock_prof_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					     handle, flags);
+	}
+
+	switch (smc_fid) {
+	case VEN_EL3_SVC_CALL_COUNT:
+#if NS_SHARED_BUF_SUPPORT
+		call_count += NS_BUF_NUM_SMC_CALLS;
+#endif
+#if SMC_MULTICALL_SUPPORT
+		call_count += MULTICALL_NUM_SMC_CALLS;
+#endif
+#if ENABLE_LOCK_PROFILING
+		call_count += LOCK_PROF_NUM_SMC_CALLS;
+#endif
+		SMC_RET1(handle, call_count);
+
+	case VEN_EL3_SVC_UID:
+		/* Return UID to the caller */
+		SMC_UUID_RET(handle, ven_el3_svc_uid);
+
+	case VEN_EL3_SVC_VERSION:
+		/* Return the version of current implementation */
+		SMC_RET2(handle, VEN_EL3_SVC_VERSION_MAJOR,
+			 VEN_EL3_SVC_VERSION_MINOR);
+
+	default:
+		WARN("Unimplemented Vendor-Specific EL3 Service Call: 0x%x\n",
+		     smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
+
+/* Register Vendor-Specific EL3 Monitor Service Calls as runtime service */
+DECLARE_RT_SVC(
+	ven_el3_svc,
+	OEN_VEN_EL3_START,
+	OEN_VEN_EL3_END,
+	SMC_TYPE_FAST,
+	NULL,
+	ven_el3_svc_handler
+);
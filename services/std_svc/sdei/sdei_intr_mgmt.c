@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -95,13 +95,13 @@ void sdei_pe_unmask(void)
 		for_each_shared_map(i, map) {
 			se = get_event_entry(map);
 
-			sdei_map_lock(map);
+			sdei_map_read_lock(map);
 			if (is_map_bound(map) && GET_EV_STATE(se, ENABLED) &&
 					(se->reg_flags == SDEI_REGF_RM_PE) &&
 					(se->affinity == my_mpidr)) {
 				plat_ic_enable_interrupt(map->intr);
 			}
-			sdei_map_unlock(map);
+			sdei_map_read_unlock(map);
 		}
 	}
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -551,7 +551,7 @@ static int64_t sdei_event_get_info(int ev_num, int info)
 	se = get_event_entry(map);
 
 	if (is_event_shared(map))
-		sdei_map_lock(map);
+		sdei_map_read_lock(map);
 
 	/* Sample state under lock */
 	registered = GET_EV_STATE(se, REGISTERED);
@@ -559,7 +559,7 @@ static int64_t sdei_event_get_info(int ev_num, int info)
 	affinity = se->affinity;
 
 	if (is_event_shared(map))
-		sdei_map_unlock(map);
+		sdei_map_read_unlock(map);
 
 	switch (info) {
 	case SDEI_INFO_EV_TYPE:
@@ -679,13 +679,13 @@ static int sdei_event_status(int ev_num)
 	se = get_event_entry(map);
 
 	if (is_event_shared(map))
-		sdei_map_lock(map);
+		sdei_map_read_lock(map);
 
 	/* State value directly maps to the expected return format */
 	state = se->state;
 
 	if (is_event_shared(map))
-		sdei_map_unlock(map);
+		sdei_map_read_unlock(map);
 
 	return (int) state;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,7 +16,7 @@
 #include <common/debug.h>
 #include <context.h>
 #include <lib/el3_runtime/context_mgmt.h>
-#include <lib/spinlock.h>
+#include <lib/rwlock.h>
 #include <lib/utils_def.h>
 #include <plat/common/platform.h>
 #include <services/sdei.h>
@@ -216,12 +216,26 @@ typedef enum {
 
 static inline void sdei_map_lock(sdei_ev_map_t *map)
 {
-	spin_lock(&map->lock);
+	write_lock(&map->lock);
 }
 
 static inline void sdei_map_unlock(sdei_ev_map_t *map)
 {
-	spin_unlock(&map->lock);
+	write_unlock(&map->lock);
+}
+
+/*
+ * Paths which only sample the state of a shared event take the lock for
+ * reading, so that they don't serialise against each other.
+ */
+static inline void sdei_map_read_lock(sdei_ev_map_t *map)
+{
+	read_lock(&map->lock);
+}
+
+static inline void sdei_map_read_unlock(sdei_ev_map_t *map)
+{
+	read_unlock(&map->lock);
 }
 
 extern const sdei_mapping_t sdei_global_mappings[];
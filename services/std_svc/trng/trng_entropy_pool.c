@@ -25,7 +25,7 @@ static uint32_t entropy_bit_index;
 /* then number of valid bits in the entropy pool */
 static uint32_t entropy_bit_size;
 
-static spinlock_t trng_pool_lock;
+static ticketlock_t trng_pool_lock;
 
 #define BITS_PER_WORD (sizeof(entropy[0]) * 8)
 #define BITS_IN_POOL (WORDS_IN_POOL * BITS_PER_WORD)
@@ -67,7 +67,7 @@ bool trng_pack_entropy(uint32_t nbits, uint64_t *out)
 {
 	bool success = true;
 
-	spin_lock(&trng_pool_lock);
+	ticket_lock(&trng_pool_lock);
 
 	if (!trng_fill_entropy(nbits)) {
 		success = false;
@@ -134,7 +134,7 @@ bool trng_pack_entropy(uint32_t nbits, uint64_t *out)
 	entropy_bit_size -= nbits;
 
 out:
-	spin_unlock(&trng_pool_lock);
+	ticket_unlock(&trng_pool_lock);
 
 	return success;
 }
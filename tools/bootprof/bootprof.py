@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Render the boot profile printed by BL31 when built with BOOT_PROFILING=1 as a
+# timeline. The input is a console log holding the 'BOOT_PROF:' lines, which
+# may be mixed with any other output. The records are described in
+# include/lib/boot_prof.h.
+#
+# Usage: bootprof.py [console.log]
+
+import re
+import sys
+
+steps = {1: 'stage', 2: 'early_platform_setup', 3: 'plat_arch_setup',
+         4: 'platform_setup', 5: 'load_image', 6: 'io_read', 7: 'auth',
+         8: 'hash', 9: 'sig_verify', 10: 'decompress',
+         11: 'runtime_svc_init', 12: 'bl32_init'}
+
+# Steps whose argument is an image ID, as defined in
+# include/export/common/tbbr/tbbr_img_def_exp.h
+image_steps = (5, 6, 7, 8, 9)
+
+images = {0: 'FIP', 1: 'BL2', 2: 'SCP_BL2', 3: 'BL31', 4: 'BL32', 5: 'BL33',
+          6: 'TRUSTED_BOOT_FW_CERT', 7: 'TRUSTED_KEY_CERT',
+          8: 'SCP_FW_KEY_CERT', 9: 'SOC_FW_KEY_CERT',
+          10: 'TRUSTED_OS_FW_KEY_CERT', 11: 'NON_TRUSTED_FW_KEY_CERT',
+          12: 'SCP_FW_CONTENT_CERT', 13: 'SOC_FW_CONTENT_CERT',
+          14: 'TRUSTED_OS_FW_CONTENT_CERT',
+          15: 'NON_TRUSTED_FW_CONTENT_CERT', 21: 'BL32_EXTRA1',
+          22: 'BL32_EXTRA2', 23: 'HW_CONFIG', 24: 'TB_FW_CONFIG',
+          25: 'SOC_FW_CONFIG', 26: 'TOS_FW_CONFIG', 27: 'NT_FW_CONFIG'}
+
+hdr_re = re.compile(r'BOOT_PROF: cntfrq (\d+) dropped (\d+)')
+rec_re = re.compile(r'BOOT_PROF: (\d+) (\d+) (\d+) ([BE]) (\d+)')
+
+
+def step_name(step, arg):
+    name = steps.get(step, 'step%d' % step)
+    if step in image_steps:
+        name += ' ' + images.get(arg, 'image%d' % arg)
+    return name
+
+
+def main():
+    log = open(sys.argv[1]) if len(sys.argv) > 1 else sys.stdin
+
+    freq = None
+    dropped = 0
+    records = []
+    for line in log:
+        m = hdr_re.search(line)
+        if m:
+            freq = int(m.group(1))
+            dropped = int(m.group(2))
+            continue
+        m = rec_re.search(line)
+        if m:
+            (ts, stage, step, end, arg) = m.groups()
+            records.append((int(ts), int(stage), int(step), end == 'E',
+                            int(arg)))
+
+    if freq is None or freq == 0:
+        sys.exit('No boot profile found')
+    if dropped != 0:
+        print('warning: %d records were dropped, increase '
+              'PLAT_BOOT_PROF_MAX_RECORDS' % dropped)
+
+    # The records of each stage are in order, but a stage may have imported
+    # those of the previous ones after making its first records.
+    records.sort(key=lambda r: r[0])
+    t0 = records[0][0] if records else 0
+
+    def ms(ticks):
+        return ticks * 1000.0 / freq
+
+    print('%10s %10s  %s' % ('start (ms)', 'time (ms)', 'step'))
+
+    # Match the end of each step with its beginning in the same stage.
+    stack = []
+    for (ts, stage, step, end, arg) in records:
+        if not end:
+            stack.append((ts, stage, step, arg))
+            print('%10.3f %10s  %sBL%d %s' % (ms(ts - t0), '...',
+                  '  ' * (len(stack) - 1), stage, step_name(step, arg)))
+            continue
+
+        for i in range(len(stack) - 1, -1, -1):
+            if stack[i][1:] == (stage, step, arg):
+                break
+        else:
+            print('warning: end of BL%d %s without a beginning' %
+                  (stage, step_name(step, arg)))
+            continue
+
+        (start, _, _, _) = stack[i]
+        print('%10.3f %10.3f  %sBL%d %s done' % (ms(start - t0),
+              ms(ts - start), '  ' * i, stage, step_name(step, arg)))
+        del stack[i:]
+
+    for (start, stage, step, arg) in stack:
+        print('warning: BL%d %s never ended' % (stage, step_name(step, arg)))
+
+    if records:
+        print('total: %.3f ms' % ms(records[-1][0] - t0))
+
+
+if __name__ == '__main__':
+    main()
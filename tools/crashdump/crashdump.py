@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Decode the crash records saved by BL31 when built with CRASH_DUMP_MEM=1.
+# The input is a raw image of the PLAT_CRASH_DUMP_BASE region, for example
+# read back from a debugger or from /dev/mem after a reset. The layout is
+# described in include/bl31/crash_dump.h.
+#
+# Usage: crashdump.py <dump.bin> [<bl31.elf>]
+#
+# If the BL31 ELF file is given, addresses in the backtrace are resolved to
+# symbols with addr2line.
+
+import struct
+import subprocess
+import sys
+
+CRASH_DUMP_MAGIC = 0x44434654
+CRASH_DUMP_VERSION = 1
+CRASH_DUMP_HDR_SIZE = 0x40
+CRASH_DUMP_REC_SIZE = 0x300
+CRASH_RECORD_MAGIC = 0x52434654
+CRASH_DUMP_BT_DEPTH = 16
+
+reasons = ['PANIC', 'Unhandled Exception', 'Unhandled Interrupt']
+
+el3_regs = ['scr_el3', 'sctlr_el3', 'cptr_el3', 'tcr_el3', 'daif',
+            'mair_el3', 'spsr_el3', 'elr_el3', 'ttbr0_el3', 'esr_el3',
+            'far_el3']
+
+non_el3_regs = ['spsr_el1', 'elr_el1', 'spsr_abt', 'spsr_und', 'spsr_irq',
+                'spsr_fiq', 'sctlr_el1', 'actlr_el1', 'cpacr_el1',
+                'csselr_el1', 'sp_el1', 'esr_el1', 'ttbr0_el1', 'ttbr1_el1',
+                'mair_el1', 'amair_el1', 'tcr_el1', 'tpidr_el1', 'tpidr_el0',
+                'tpidrro_el0', 'par_el1', 'mpidr_el1', 'afsr0_el1',
+                'afsr1_el1', 'contextidr_el1', 'vbar_el1', 'cntp_ctl_el0',
+                'cntp_cval_el0', 'cntv_ctl_el0', 'cntv_cval_el0',
+                'cntkctl_el1', 'sp_el0', 'isr_el1']
+
+gp_regs = ['x%d' % i for i in range(31)]
+
+
+def symbolize(elf, addrs):
+    if elf is None or not addrs:
+        return {}
+    try:
+        out = subprocess.run(['addr2line', '-f', '-e', elf] +
+                             ['0x%x' % a for a in addrs],
+                             stdout=subprocess.PIPE, check=True,
+                             universal_newlines=True).stdout.splitlines()
+    except (OSError, subprocess.CalledProcessError):
+        return {}
+    return {a: '%s (%s)' % (out[2 * i], out[2 * i + 1])
+            for i, a in enumerate(addrs)}
+
+
+def print_regs(names, values):
+    for name, value in zip(names, values):
+        print('  %-16s0x%016x' % (name, value))
+
+
+def decode_record(rec, elf):
+    magic, reason, seq, mpidr, cntpct = struct.unpack_from('<IIQQQ', rec, 0)
+    off = 0x20
+    gp = struct.unpack_from('<%dQ' % len(gp_regs), rec, off)
+    off += 8 * len(gp_regs)
+    el3 = struct.unpack_from('<%dQ' % len(el3_regs), rec, off)
+    off += 8 * len(el3_regs)
+    non_el3 = struct.unpack_from('<%dQ' % len(non_el3_regs), rec, off)
+    off += 8 * len(non_el3_regs)
+    bt_count, = struct.unpack_from('<Q', rec, off)
+    bt = struct.unpack_from('<%dQ' % CRASH_DUMP_BT_DEPTH, rec, off + 8)
+    bt = bt[:min(bt_count, CRASH_DUMP_BT_DEPTH)]
+
+    reason = reasons[reason] if reason < len(reasons) else str(reason)
+    print('Record %d: %s on CPU 0x%x, cntpct 0x%x' %
+          (seq, reason, mpidr, cntpct))
+    print_regs(gp_regs, gp)
+    print_regs(el3_regs, el3)
+    print_regs(non_el3_regs, non_el3)
+
+    syms = symbolize(elf, list(bt))
+    print('  backtrace:')
+    for i, addr in enumerate(bt):
+        print('    %2d: 0x%016x %s' % (i, addr, syms.get(addr, '')))
+    print('')
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit('usage: %s <dump.bin> [<bl31.elf>]' % sys.argv[0])
+
+    with open(sys.argv[1], 'rb') as f:
+        data = f.read()
+    elf = sys.argv[2] if len(sys.argv) > 2 else None
+
+    magic, version, rec_size, num_recs, next_seq = \
+        struct.unpack_from('<IIIIQ', data, 0)
+    if magic != CRASH_DUMP_MAGIC:
+        sys.exit('No crash dump found (magic 0x%x)' % magic)
+    if version != CRASH_DUMP_VERSION or rec_size != CRASH_DUMP_REC_SIZE:
+        sys.exit('Unsupported crash dump version %d (record size 0x%x)' %
+                 (version, rec_size))
+
+    records = []
+    for i in range(num_recs):
+        start = CRASH_DUMP_HDR_SIZE + i * rec_size
+        rec = data[start:start + rec_size]
+        if len(rec) < rec_size:
+            break
+        if struct.unpack_from('<I', rec, 0)[0] == CRASH_RECORD_MAGIC:
+            records.append((struct.unpack_from('<Q', rec, 8)[0], rec))
+
+    print('%d crash record(s), %d crash(es) since the region was set up\n' %
+          (len(records), next_seq))
+    for _, rec in sorted(records, key=lambda r: r[0]):
+        decode_record(rec, elf)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * BL33 payload measuring the latency of EL3 runtime services on QEMU virt.
+ *
+ * Each benchmark issues the same SMC EL3_BENCH_ITERATIONS times, after
+ * EL3_BENCH_WARMUP calls which aren't recorded, and prints the distribution of
+ * the number of system counter ticks each call took, for run_el3_bench.py to
+ * parse. When QEMU runs with '-icount shift=4', one tick is one instruction,
+ * so the results are exact and repeatable.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef EL3_BENCH_ITERATIONS
+#define EL3_BENCH_ITERATIONS	256
+#endif
+#define EL3_BENCH_WARMUP	16
+
+/* PL011 UART0 of QEMU virt */
+#define UART_BASE		0x09000000UL
+#define UARTDR			0x000
+#define UARTFR			0x018
+#define UARTFR_TXFF		(1U << 5)
+
+/* GICv2 of QEMU virt */
+#define GICD_BASE		0x08000000UL
+#define GICC_BASE		0x08010000UL
+#define GICD_CTLR		0x000
+#define GICD_ISENABLER		0x100
+#define GICD_IPRIORITYR		0x400
+#define GICD_PIDR2		0xfe8
+#define GICC_CTLR		0x000
+#define GICC_PMR		0x004
+#define GIC_ARCH_REV(pidr2)	(((pidr2) >> 4) & 0xfU)
+/* PPI of the Non-secure physical timer */
+#define NS_TIMER_INTID		30U
+
+/* Function IDs, see include/services and include/lib */
+#define SMCCC_VERSION		0x80000000U
+#define SMCCC_ARCH_WORKAROUND_1	0x80008000U
+#define PSCI_VERSION		0x84000000U
+#define PSCI_CPU_SUSPEND_AARCH64 0xc4000001U
+#define PMF_GET_TIMESTAMP_64	0xc2000010U
+#define SDEI_VERSION		0xc4000020U
+#define TRNG_VERSION		0x84000050U
+#define TRNG_RND64		0xc4000053U
+
+/* Standby state of a CPU, with PSCI_EXTENDED_STATE_ID=0 */
+#define QEMU_CPU_STANDBY	0x1U
+/* PMF_ARM_TIF_IMPL_ID, PMF_RT_INSTR_SVC_ID and RT_INSTR_ENTER_PSCI */
+#define PMF_RT_INSTR_ENTER_PSCI	((0x41U << 24) | (1U << 10) | 0U)
+
+/* Returned for unknown calls, as well as by PSCI and TRNG when unsupported */
+#define NOT_SUPPORTED		-1
+
+uint64_t el3_bench_smc(uint64_t fid, uint64_t x1, uint64_t x2, uint64_t x3,
+		       uint64_t *ret);
+uint64_t el3_bench_overhead(void);
+uint64_t el3_bench_read_cntfrq(void);
+uint64_t el3_bench_read_mpidr(void);
+void el3_bench_timer_fire(void);
+void el3_bench_timer_stop(void);
+void el3_bench_entrypoint(void);
+void el3_bench_main(void);
+
+typedef struct el3_bench {
+	const char *name;
+	uint32_t fid;
+	uint64_t x1;
+	uint64_t x2;
+	uint64_t x3;
+	/* Called before and after the calls of the benchmark, if not NULL */
+	int (*setup)(struct el3_bench *bench);
+	void (*teardown)(void);
+} el3_bench_t;
+
+static uint64_t samples[EL3_BENCH_ITERATIONS];
+
+static inline uint32_t mmio_read_32(uintptr_t addr)
+{
+	return *(volatile uint32_t *)addr;
+}
+
+static inline void mmio_write_32(uintptr_t addr, uint32_t value)
+{
+	*(volatile uint32_t *)addr = value;
+}
+
+static void uart_putc(char c)
+{
+	while ((mmio_read_32(UART_BASE + UARTFR) & UARTFR_TXFF) != 0U)
+		;
+	mmio_write_32(UART_BASE + UARTDR, (uint32_t)c);
+}
+
+static void uart_puts(const char *s)
+{
+	while (*s != '\0') {
+		if (*s == '\n')
+			uart_putc('\r');
+		uart_putc(*s++);
+	}
+}
+
+static void put_num(uint64_t n, unsigned int radix)
+{
+	char buf[20];
+	unsigned int i = 0U;
+
+	do {
+		buf[i++] = "0123456789abcdef"[n % radix];
+		n /= radix;
+	} while (n != 0U);
+
+	if (radix == 16U)
+		uart_puts("0x");
+	while (i > 0U)
+		uart_putc(buf[--i]);
+}
+
+static int cpu_suspend_setup(el3_bench_t *bench)
+{
+	uintptr_t prio_reg = GICD_BASE + GICD_IPRIORITYR +
+			     (NS_TIMER_INTID & ~3U);
+	unsigned int shift = (NS_TIMER_INTID & 3U) * 8U;
+	uint32_t prio;
+
+	/*
+	 * The timer interrupt is masked at the CPU, but wakes it from WFI as
+	 * long as the GIC forwards it. Only GICv2 is handled here.
+	 */
+	if (GIC_ARCH_REV(mmio_read_32(GICD_BASE + GICD_PIDR2)) != 2U)
+		return NOT_SUPPORTED;
+
+	prio = mmio_read_32(prio_reg);
+	prio &= ~(0xffU << shift);
+	prio |= 0x80U << shift;
+	mmio_write_32(prio_reg, prio);
+	mmio_write_32(GICD_BASE + GICD_ISENABLER, 1U << NS_TIMER_INTID);
+	mmio_write_32(GICD_BASE + GICD_CTLR, 1U);
+	mmio_write_32(GICC_BASE + GICC_PMR, 0xffU);
+	mmio_write_32(GICC_BASE + GICC_CTLR, 1U);
+
+	el3_bench_timer_fire();
+	bench->x2 = (uintptr_t)el3_bench_entrypoint;
+
+	return 0;
+}
+
+static int pmf_setup(el3_bench_t *bench)
+{
+	bench->x2 = el3_bench_read_mpidr();
+
+	return 0;
+}
+
+static el3_bench_t benchmarks[] = {
+	{ "smccc_version", SMCCC_VERSION, 0U, 0U, 0U, NULL, NULL },
+	{ "smccc_arch_workaround_1", SMCCC_ARCH_WORKAROUND_1, 0U, 0U, 0U,
+	  NULL, NULL },
+	{ "psci_version", PSCI_VERSION, 0U, 0U, 0U, NULL, NULL },
+	{ "psci_cpu_suspend_standby", PSCI_CPU_SUSPEND_AARCH64,
+	  QEMU_CPU_STANDBY, 0U, 0U, cpu_suspend_setup, el3_bench_timer_stop },
+	{ "trng_version", TRNG_VERSION, 0U, 0U, 0U, NULL, NULL },
+	{ "trng_rnd64", TRNG_RND64, 64U, 0U, 0U, NULL, NULL },
+	{ "sdei_version", SDEI_VERSION, 0U, 0U, 0U, NULL, NULL },
+	{ "pmf_get_timestamp_64", PMF_GET_TIMESTAMP_64,
+	  PMF_RT_INSTR_ENTER_PSCI, 0U, 0U, pmf_setup, NULL },
+};
+
+static void sort_samples(void)
+{
+	unsigned int i, j;
+	uint64_t s;
+
+	for (i = 1U; i < EL3_BENCH_ITERATIONS; i++) {
+		s = samples[i];
+		for (j = i; (j > 0U) && (samples[j - 1U] > s); j--)
+			samples[j] = samples[j - 1U];
+		samples[j] = s;
+	}
+}
+
+static void print_results(const char *name, uint64_t fid)
+{
+	uint64_t sum = 0U;
+	unsigned int i;
+
+	sort_samples();
+	for (i = 0U; i < EL3_BENCH_ITERATIONS; i++)
+		sum += samples[i];
+
+	uart_puts("EL3_BENCH: ");
+	uart_puts(name);
+	uart_puts(" fid ");
+	put_num(fid, 16U);
+	uart_puts(" min ");
+	put_num(samples[0], 10U);
+	uart_puts(" median ");
+	put_num(samples[EL3_BENCH_ITERATIONS / 2], 10U);
+	uart_puts(" max ");
+	put_num(samples[EL3_BENCH_ITERATIONS - 1], 10U);
+	uart_puts(" mean ");
+	put_num(sum / EL3_BENCH_ITERATIONS, 10U);
+	uart_puts("\n");
+}
+
+static void run_benchmark(el3_bench_t *bench)
+{
+	uint64_t ret;
+	unsigned int i;
+	int rc = 0;
+
+	if (bench->setup != NULL)
+		rc = bench->setup(bench);
+
+	/* The first call tells whether the service is there at all. */
+	if (rc == 0) {
+		(void)el3_bench_smc(bench->fid, bench->x1, bench->x2,
+				    bench->x3, &ret);
+		rc = ((int32_t)ret == NOT_SUPPORTED) ? NOT_SUPPORTED : 0;
+	}
+
+	if (rc == 0) {
+		for (i = 0U; i < EL3_BENCH_WARMUP; i++)
+			(void)el3_bench_smc(bench->fid, bench->x1, bench->x2,
+					    bench->x3, &ret);
+
+		for (i = 0U; i < EL3_BENCH_ITERATIONS; i++)
+			samples[i] = el3_bench_smc(bench->fid, bench->x1,
+						   bench->x2, bench->x3, &ret);
+	}
+
+	if (bench->teardown != NULL)
+		bench->teardown();
+
+	if (rc == 0) {
+		print_results(bench->name, bench->fid);
+	} else {
+		uart_puts("EL3_BENCH: ");
+		uart_puts(bench->name);
+		uart_puts(" unsupported\n");
+	}
+}
+
+void el3_bench_main(void)
+{
+	unsigned int i;
+
+	uart_puts("EL3_BENCH: cntfrq ");
+	put_num(el3_bench_read_cntfrq(), 10U);
+	uart_puts(" iterations ");
+	put_num(EL3_BENCH_ITERATIONS, 10U);
+	uart_puts("\n");
+
+	for (i = 0U; i < EL3_BENCH_ITERATIONS; i++)
+		samples[i] = el3_bench_overhead();
+	print_results("overhead", 0U);
+
+	for (i = 0U; i < (sizeof(benchmarks) / sizeof(benchmarks[0])); i++)
+		run_benchmark(&benchmarks[i]);
+
+	uart_puts("EL3_BENCH: done\n");
+}
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Run the EL3 benchmark payload on QEMU virt, or parse the console log of an
+# earlier run, and write the results as JSON. When a baseline from an earlier
+# run is given, exit with an error if the median latency of any benchmark
+# grew by more than the given threshold.
+#
+# With '-icount shift=4', which is the default, QEMU runs one instruction every
+# 16 ns and the system counter of QEMU virt ticks at 62.5 MHz, so the results
+# are the number of instructions each call took, and don't depend on the load
+# of the host.
+
+import argparse
+import json
+import re
+import subprocess
+import sys
+
+hdr_re = re.compile(r'EL3_BENCH: cntfrq (\d+) iterations (\d+)')
+res_re = re.compile(r'EL3_BENCH: (\w+) fid (0x[0-9a-f]+) min (\d+) '
+                    r'median (\d+) max (\d+) mean (\d+)')
+unsup_re = re.compile(r'EL3_BENCH: (\w+) unsupported')
+
+
+def run_qemu(args):
+    cmd = [args.qemu, '-nographic', '-machine', 'virt,secure=on',
+           '-cpu', args.cpu, '-smp', '1', '-m', '1024', '-bios', args.bios,
+           '-semihosting-config', 'enable,target=native', '-d', 'unimp']
+    if args.icount:
+        cmd += ['-icount', 'shift=4,sleep=off']
+
+    try:
+        proc = subprocess.run(cmd, cwd=args.dir, stdout=subprocess.PIPE,
+                              stderr=subprocess.STDOUT,
+                              timeout=args.timeout)
+    except subprocess.TimeoutExpired as e:
+        sys.stdout.write((e.stdout or b'').decode(errors='replace'))
+        sys.exit('QEMU timed out after %d s' % args.timeout)
+
+    return proc.stdout.decode(errors='replace')
+
+
+def parse(log, icount):
+    results = {'icount': icount, 'benchmarks': {}}
+    done = False
+
+    for line in log.splitlines():
+        m = hdr_re.search(line)
+        if m:
+            results['cntfrq'] = int(m.group(1))
+            results['iterations'] = int(m.group(2))
+            continue
+        m = res_re.search(line)
+        if m:
+            (name, fid) = m.groups()[:2]
+            (lo, med, hi, mean) = [int(v) for v in m.groups()[2:]]
+            results['benchmarks'][name] = {
+                'supported': True, 'fid': fid, 'min': lo, 'median': med,
+                'max': hi, 'mean': mean}
+            continue
+        m = unsup_re.search(line)
+        if m:
+            results['benchmarks'][m.group(1)] = {'supported': False}
+            continue
+        if 'EL3_BENCH: done' in line:
+            done = True
+
+    if not done:
+        sys.stdout.write(log)
+        sys.exit('The benchmark payload didn\'t complete')
+
+    return results
+
+
+def compare(results, baseline, threshold):
+    failed = False
+
+    print('%-28s %10s %10s %8s' % ('benchmark', 'baseline', 'median',
+                                   'change'))
+    for (name, base) in sorted(baseline['benchmarks'].items()):
+        if not base['supported'] or name == 'overhead':
+            continue
+        cur = results['benchmarks'].get(name)
+        if cur is None or not cur['supported']:
+            print('%-28s %10d %10s %8s  MISSING' % (name, base['median'],
+                                                   '-', '-'))
+            failed = True
+            continue
+
+        change = 100.0 * (cur['median'] - base['median']) / \
+            max(base['median'], 1)
+        status = ''
+        if change > threshold:
+            status = '  REGRESSION'
+            failed = True
+        print('%-28s %10d %10d %+7.1f%%%s' % (name, base['median'],
+                                              cur['median'], change, status))
+
+    return not failed
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measure the latency of EL3 runtime services on QEMU')
+    parser.add_argument('--log', help='parse this console log instead of '
+                        'running QEMU')
+    parser.add_argument('--qemu', default='qemu-system-aarch64')
+    parser.add_argument('--cpu', default='cortex-a57')
+    parser.add_argument('--bios', default='bl1.bin',
+                        help='BL1, or BL1 and the FIP in a flash image')
+    parser.add_argument('--dir', default='.',
+                        help='directory to run QEMU in, which holds the '
+                        'images loaded with semihosting')
+    parser.add_argument('--no-icount', dest='icount', action='store_false',
+                        help='measure time instead of instructions')
+    parser.add_argument('--timeout', type=int, default=300)
+    parser.add_argument('--output', help='write the results to this file')
+    parser.add_argument('--baseline', help='results of an earlier run to '
+                        'compare with')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='largest increase of a median allowed, in '
+                        'percent')
+    args = parser.parse_args()
+
+    if args.log:
+        with open(args.log) as f:
+            log = f.read()
+    else:
+        log = run_qemu(args)
+
+    results = parse(log, args.icount)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(results, f, indent=4, sort_keys=True)
+            f.write('\n')
+    else:
+        json.dump(results, sys.stdout, indent=4, sort_keys=True)
+        sys.stdout.write('\n')
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if baseline.get('icount') != results['icount']:
+            sys.exit('The baseline wasn\'t measured in the same icount mode')
+        if not compare(results, baseline, args.threshold):
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef HOST_TESTS_H
+#define HOST_TESTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct host_test {
+	const char *name;
+	void (*fn)(void);
+	/* Benchmarks only run when requested with -b or by name */
+	bool bench;
+} host_test_t;
+
+/*
+ * Tests register themselves in the host_tests section, in the same way as
+ * runtime services do in rt_svc_descs, so that adding a test only requires
+ * adding its file to the Makefile.
+ */
+#define HOST_TEST_REGISTER(_name, _bench)				\
+	static void _name(void);					\
+	static const host_test_t _name##_desc = {			\
+		.name = #_name,						\
+		.fn = _name,						\
+		.bench = (_bench),					\
+	};								\
+	static const host_test_t *_name##_ptr				\
+		__attribute__((section("host_tests"), used)) =		\
+		&_name##_desc;						\
+	static void _name(void)
+
+#define HOST_TEST(_name)	HOST_TEST_REGISTER(_name, false)
+#define HOST_BENCH(_name)	HOST_TEST_REGISTER(_name, true)
+
+/* Set with -v, the shim only prints log messages when it is set */
+extern bool host_tests_verbose;
+
+void host_test_fail(const char *file, int line, const char *expr);
+
+/* Number of failed checks so far, in all the tests */
+unsigned int host_test_failures(void);
+
+/* Record a failure of the current test and carry on */
+#define CHECK(_expr)							\
+	do {								\
+		if (!(_expr)) {						\
+			host_test_fail(__FILE__, __LINE__, #_expr);	\
+		}							\
+	} while (false)
+
+/* Monotonic time in nanoseconds, for benchmarks */
+uint64_t host_time_ns(void);
+
+/* Print one result line of a benchmark */
+void host_bench_report(const char *what, unsigned long ops, uint64_t ns);
+
+#endif /* HOST_TESTS_H */
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "host_tests.h"
+
+/* Start and end of the host_tests section, provided by the linker */
+extern const host_test_t *__start_host_tests[];
+extern const host_test_t *__stop_host_tests[];
+
+static unsigned int failures;
+bool host_tests_verbose;
+
+void host_test_fail(const char *file, int line, const char *expr)
+{
+	printf("    %s:%d: check failed: %s\n", file, line, expr);
+	failures++;
+}
+
+unsigned int host_test_failures(void)
+{
+	return failures;
+}
+
+uint64_t host_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+void host_bench_report(const char *what, unsigned long ops, uint64_t ns)
+{
+	double secs = (double)ns / 1e9;
+
+	printf("    %-40s %12lu ops %10.1f ns/op %14.0f ops/s\n", what, ops,
+	       (ops != 0UL) ? (double)ns / (double)ops : 0.0,
+	       (secs > 0.0) ? (double)ops / secs : 0.0);
+}
+
+static void usage(const char *prog)
+{
+	printf("Usage: %s [-b] [-l] [-v] [name...]\n", prog);
+	printf("  -b    also run the benchmarks\n");
+	printf("  -l    list the tests and benchmarks\n");
+	printf("  -v    print the log messages of the code under test\n");
+	printf("  name  only run the tests whose name contains one of these\n");
+}
+
+static bool selected(const host_test_t *test, int argc, char **argv,
+		     bool run_bench)
+{
+	int i;
+
+	if (argc == 0) {
+		return !test->bench || run_bench;
+	}
+
+	for (i = 0; i < argc; i++) {
+		if (strstr(test->name, argv[i]) != NULL) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int main(int argc, char **argv)
+{
+	const host_test_t **test;
+	bool run_bench = false;
+	bool list = false;
+	unsigned int run = 0U, failed = 0U;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "bhlv")) != -1) {
+		switch (opt) {
+		case 'b':
+			run_bench = true;
+			break;
+		case 'l':
+			list = true;
+			break;
+		case 'v':
+			host_tests_verbose = true;
+			break;
+		default:
+			usage(argv[0]);
+			return (opt == 'h') ? 0 : 2;
+		}
+	}
+	argc -= optind;
+	argv += optind;
+
+	for (test = __start_host_tests; test < __stop_host_tests; test++) {
+		unsigned int before = failures;
+
+		if (list) {
+			printf("%s%s\n", (*test)->name,
+			       (*test)->bench ? " (benchmark)" : "");
+			continue;
+		}
+
+		if (!selected(*test, argc, argv, run_bench)) {
+			continue;
+		}
+
+		printf("[ RUN  ] %s\n", (*test)->name);
+		fflush(stdout);
+		(*test)->fn();
+		run++;
+
+		if (failures != before) {
+			printf("[ FAIL ] %s\n", (*test)->name);
+			failed++;
+		} else {
+			printf("[  OK  ] %s\n", (*test)->name);
+		}
+	}
+
+	if (!list) {
+		printf("%u run, %u failed\n", run, failed);
+	}
+
+	return (failed == 0U) ? 0 : 1;
+}
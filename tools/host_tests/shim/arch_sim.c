@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <arch_sim.h>
+
+arch_sim_stats_t arch_sim_stats;
+bool arch_sim_mmu_enabled;
+
+void arch_sim_reset(void)
+{
+	(void)memset(&arch_sim_stats, 0, sizeof(arch_sim_stats));
+	arch_sim_mmu_enabled = false;
+}
+
+static void dc_range(uintptr_t addr, size_t size)
+{
+	uintptr_t start = addr & ~(uintptr_t)(CACHE_WRITEBACK_GRANULE - 1U);
+
+	if (size == 0U) {
+		return;
+	}
+
+	arch_sim_stats.dc_lines += ((addr + size - start) +
+				    CACHE_WRITEBACK_GRANULE - 1U) /
+				   CACHE_WRITEBACK_GRANULE;
+}
+
+void dccvac(uintptr_t addr)
+{
+	dc_range(addr, 1U);
+}
+
+void dcivac(uintptr_t addr)
+{
+	dc_range(addr, 1U);
+}
+
+void dccivac(uintptr_t addr)
+{
+	dc_range(addr, 1U);
+}
+
+void clean_dcache_range(uintptr_t addr, size_t size)
+{
+	dc_range(addr, size);
+}
+
+void inv_dcache_range(uintptr_t addr, size_t size)
+{
+	dc_range(addr, size);
+}
+
+void flush_dcache_range(uintptr_t addr, size_t size)
+{
+	dc_range(addr, size);
+}
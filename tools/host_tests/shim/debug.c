@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <common/debug.h>
+#include <drivers/console.h>
+#include <plat/common/platform.h>
+
+#include "host_tests.h"
+
+/*
+ * Host replacement of common/tf_log.c and of the assertion, panic and console
+ * hooks. Log messages are only printed with -v, as many tests exercise error
+ * paths on purpose.
+ */
+void tf_log(const char *fmt, ...)
+{
+	va_list args;
+
+	if (!host_tests_verbose) {
+		return;
+	}
+
+	/* Skip the log level marker */
+	fmt++;
+
+	printf("    ");
+	va_start(args, fmt);
+	vprintf(fmt, args);
+	va_end(args);
+}
+
+void tf_log_set_max_level(unsigned int log_level)
+{
+	(void)log_level;
+}
+
+void console_flush(void)
+{
+	fflush(stdout);
+}
+
+void do_panic(void)
+{
+	printf("    panic\n");
+	fflush(stdout);
+	abort();
+}
+
+/* Failed assertion in the firmware C library, built with LOG_LEVEL=40 */
+void __assert(const char *file, unsigned int line)
+{
+	printf("    assertion failed: %s:%u\n", file, line);
+	do_panic();
+}
+
+void plat_panic_handler(void)
+{
+	do_panic();
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_FEATURES_H
+#define ARCH_FEATURES_H
+
+#include <stdbool.h>
+
+/*
+ * Host replacement of include/arch/aarch64/arch_features.h. The simulated PE
+ * implements none of the optional features used by the sources under test.
+ */
+
+static inline bool is_armv8_4_tlbi_range_present(void)
+{
+	return false;
+}
+
+static inline bool is_armv8_5_bti_present(void)
+{
+	return false;
+}
+
+#endif /* ARCH_FEATURES_H */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_HELPERS_H
+#define ARCH_HELPERS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Host replacement of include/arch/aarch64/arch_helpers.h. Only the helpers
+ * used by the sources under test are provided.
+ *
+ * The firmware headers are built with __aarch64__ defined on every host, so
+ * __ARM_ARCH tells whether the host really is an Arm machine. If so, the
+ * barriers are the real instructions, elsewhere they are full compiler and
+ * CPU fences, which are at least as strong.
+ */
+
+#ifdef __ARM_ARCH
+#define DEFINE_SYSOP_TYPE_FUNC(_op, _type)				\
+static inline void _op##_type(void)					\
+{									\
+	__asm__ volatile (#_op " " #_type : : : "memory");		\
+}
+#else
+#define DEFINE_SYSOP_TYPE_FUNC(_op, _type)				\
+static inline void _op##_type(void)					\
+{									\
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);			\
+}
+#endif
+
+DEFINE_SYSOP_TYPE_FUNC(dmb, ish)
+DEFINE_SYSOP_TYPE_FUNC(dmb, ishld)
+DEFINE_SYSOP_TYPE_FUNC(dmb, ishst)
+DEFINE_SYSOP_TYPE_FUNC(dsb, ish)
+DEFINE_SYSOP_TYPE_FUNC(dsb, ishst)
+
+static inline void isb(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/*
+ * Data cache maintenance. The host caches are coherent, so these only count
+ * the operations, see shim/arch_sim.c.
+ */
+void dccvac(uintptr_t addr);
+void dcivac(uintptr_t addr);
+void dccivac(uintptr_t addr);
+void clean_dcache_range(uintptr_t addr, size_t size);
+void inv_dcache_range(uintptr_t addr, size_t size);
+void flush_dcache_range(uintptr_t addr, size_t size);
+
+/* The data cache is considered enabled, as after BL31 early setup */
+static inline _Bool is_dcache_enabled(void)
+{
+	return 1;
+}
+
+#endif /* ARCH_HELPERS_H */
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_SIM_H
+#define ARCH_SIM_H
+
+#include <stdbool.h>
+
+/*
+ * State of the simulated PE. The maintenance operations are not needed on the
+ * host, they are only counted so that tests and benchmarks can report them.
+ */
+typedef struct arch_sim_stats {
+	/* Data cache lines cleaned and/or invalidated */
+	unsigned long dc_lines;
+	/* TLB invalidations by VA, by range and of a whole regime */
+	unsigned long tlbi_va;
+	unsigned long tlbi_range;
+	unsigned long tlbi_all;
+	/* DSB + ISB sequences completing TLB invalidations */
+	unsigned long tlbi_sync;
+} arch_sim_stats_t;
+
+extern arch_sim_stats_t arch_sim_stats;
+
+/* SCTLR_ELx.M of the simulated PE, for all the translation regimes */
+extern bool arch_sim_mmu_enabled;
+
+void arch_sim_reset(void);
+
+static inline unsigned long arch_sim_tlbi_count(void)
+{
+	return arch_sim_stats.tlbi_va + arch_sim_stats.tlbi_range +
+	       arch_sim_stats.tlbi_all;
+}
+
+#endif /* ARCH_SIM_H */
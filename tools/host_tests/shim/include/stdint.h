@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef HOST_STDINT_H
+#define HOST_STDINT_H
+
+#include_next <stdint.h>
+
+/* Types that the firmware C library adds to <stdint.h> */
+typedef long register_t;
+typedef unsigned long u_register_t;
+
+#endif /* HOST_STDINT_H */
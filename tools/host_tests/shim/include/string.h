@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef HOST_STRING_H
+#define HOST_STRING_H
+
+#include_next <string.h>
+
+/*
+ * Not all the host C libraries have strlcpy() and strlcat(), so the sources
+ * under test use those of the firmware C library.
+ */
+size_t tf_strlcpy(char *dst, const char *src, size_t dsize);
+size_t tf_strlcat(char *dst, const char *src, size_t dsize);
+
+#define strlcpy		tf_strlcpy
+#define strlcat		tf_strlcat
+
+#endif /* HOST_STRING_H */
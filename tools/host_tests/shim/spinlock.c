@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <sched.h>
+
+#include <lib/spinlock.h>
+
+/*
+ * Host replacement of lib/locks/exclusive/aarch64/spinlock.S, used on hosts
+ * which cannot run the AArch64 implementation.
+ */
+void spin_lock(spinlock_t *lock)
+{
+	while (__atomic_exchange_n(&lock->lock, 1U, __ATOMIC_ACQUIRE) != 0U) {
+		while (lock->lock != 0U) {
+		}
+	}
+}
+
+void spin_unlock(spinlock_t *lock)
+{
+	__atomic_store_n(&lock->lock, 0U, __ATOMIC_RELEASE);
+}
+
+/*
+ * The waiters yield the CPU, as the host may run more threads than it has
+ * CPUs and a waiter spinning through its time slice would then delay the
+ * threads ahead of it in the queue.
+ */
+void ticket_lock(ticketlock_t *lock)
+{
+	uint32_t ticket;
+
+	ticket = __atomic_fetch_add(&lock->lock, 1U << TICKETLOCK_NEXT_SHIFT,
+				    __ATOMIC_ACQUIRE) >> TICKETLOCK_NEXT_SHIFT;
+
+	while ((__atomic_load_n(&lock->lock, __ATOMIC_ACQUIRE) & 0xffffU) !=
+	       ticket) {
+		(void)sched_yield();
+	}
+}
+
+void ticket_unlock(ticketlock_t *lock)
+{
+	uint32_t owner = (lock->lock + 1U) & 0xffffU;
+
+	__atomic_store_n((volatile uint16_t *)&lock->lock, (uint16_t)owner,
+			 __ATOMIC_RELEASE);
+}
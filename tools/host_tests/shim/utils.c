@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include <lib/utils.h>
+
+/* Host replacement of the memory helpers of lib/aarch64/misc_helpers.S */
+void zeromem(void *mem, u_register_t length)
+{
+	memset(mem, 0, length);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <arch.h>
+#include <arch_features.h>
+#include <arch_helpers.h>
+#include <arch_sim.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+
+#include "../../../lib/xlat_tables_v2/xlat_tables_private.h"
+
+/*
+ * Host replacement of lib/xlat_tables_v2/aarch64/xlat_tables_arch.c. The
+ * simulated PE runs at EL3, supports the 4KB granule and a 48-bit PA range,
+ * and the TLB maintenance operations are counted instead of issued. The
+ * choice between TLBI by VA, by range and of the whole regime follows the
+ * firmware implementation.
+ */
+
+bool xlat_arch_is_granule_size_supported(size_t size)
+{
+	return size == PAGE_SIZE_4KB;
+}
+
+size_t xlat_arch_get_max_supported_granule_size(void)
+{
+	return PAGE_SIZE_4KB;
+}
+
+unsigned long long xlat_arch_get_max_supported_pa(void)
+{
+	return (1ULL << 48) - 1ULL;
+}
+
+uintptr_t xlat_get_min_virt_addr_space_size(void)
+{
+	return MIN_VIRT_ADDR_SPACE_SIZE;
+}
+
+bool is_mmu_enabled_ctx(const xlat_ctx_t *ctx)
+{
+	assert(ctx->xlat_regime != EL_REGIME_INVALID);
+
+	return arch_sim_mmu_enabled;
+}
+
+uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		return UPPER_ATTRS(UXN) | UPPER_ATTRS(PXN);
+	} else {
+		assert((xlat_regime == EL2_REGIME) ||
+		       (xlat_regime == EL3_REGIME));
+		return UPPER_ATTRS(XN);
+	}
+}
+
+void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
+{
+	assert(xlat_regime != EL_REGIME_INVALID);
+
+	arch_sim_stats.tlbi_va++;
+}
+
+void xlat_arch_tlbi_batch_flush(const xlat_tlbi_batch_t *batch)
+{
+	unsigned long long pages;
+
+	if (batch->num_va == 0U) {
+		return;
+	}
+
+	if (batch->num_va <= XLAT_TLBI_BATCH_SIZE) {
+		arch_sim_stats.tlbi_va += batch->num_va;
+	} else {
+		pages = ((batch->max_va - batch->min_va) >> PAGE_SIZE_SHIFT) +
+			1U;
+
+		if (is_armv8_4_tlbi_range_present() &&
+		    (pages < TLBIR_MAX_PAGES)) {
+			arch_sim_stats.tlbi_range++;
+		} else {
+			arch_sim_stats.tlbi_all++;
+		}
+	}
+
+	xlat_arch_tlbi_va_sync();
+}
+
+void xlat_arch_tlbi_va_sync(void)
+{
+	arch_sim_stats.tlbi_sync++;
+}
+
+unsigned int xlat_arch_current_el(void)
+{
+	return 3U;
+}
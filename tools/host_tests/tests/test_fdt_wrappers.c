@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <libfdt.h>
+
+#include <common/fdt_wrappers.h>
+
+#include "host_tests.h"
+
+#define FDT_TEST_SIZE		4096
+#define FDT_BENCH_OPS		100000UL
+
+#define FDT_UART0_PATH	"/smb@0,0/motherboard/iofpga@3,00000000/uart@a0000"
+#define FDT_UART1_PATH	"/smb@0,0/motherboard/iofpga@3,00000000/uart@b0000"
+
+static uint8_t fdt_test_dtb[FDT_TEST_SIZE];
+
+/* Add a property made of big-endian cells to the node being written */
+static int fdt_test_cells(void *fdt, const char *name, const uint32_t *cells,
+			  unsigned int count)
+{
+	fdt32_t prop[16];
+	unsigned int i;
+
+	for (i = 0U; i < count; i++) {
+		prop[i] = cpu_to_fdt32(cells[i]);
+	}
+
+	return fdt_property(fdt, name, prop, (int)(count * sizeof(fdt32_t)));
+}
+
+#define FDT_CELLS(fdt, name, ...)					\
+	do {								\
+		const uint32_t _c[] = { __VA_ARGS__ };			\
+		err |= fdt_test_cells(fdt, name, _c,			\
+				      sizeof(_c) / sizeof(_c[0]));	\
+	} while (0)
+
+/*
+ * Build the device tree used by the tests. It follows the FVP layout given as
+ * an example in fdt_wrappers.c, so a UART takes three translation steps to
+ * reach the CPU address space:
+ *
+ * / {
+ *	#address-cells = <2>;
+ *	#size-cells = <2>;
+ *	memory@80000000 {
+ *		reg = <0x0 0x80000000 0x0 0x7f000000>,
+ *		      <0x8 0x80000000 0x1 0x80000000>;
+ *		reg-names = "dram0", "dram1";
+ *	};
+ *	smb@0,0 {
+ *		#address-cells = <2>;
+ *		#size-cells = <1>;
+ *		ranges = <0 0 0 0x08000000 0x04000000>,
+ *			 <3 0 0 0x1c000000 0x04000000>;
+ *		motherboard {
+ *			#address-cells = <2>;
+ *			#size-cells = <1>;
+ *			ranges;
+ *			iofpga@3,00000000 {
+ *				#address-cells = <1>;
+ *				#size-cells = <1>;
+ *				ranges = <0 3 0 0x200000>;
+ *				uart@a0000 { ... };
+ *				uart@b0000 { ... };
+ *			};
+ *		};
+ *	};
+ *	aliases { serial0 = FDT_UART0_PATH; };
+ *	chosen { stdout-path = "serial0:115200n8"; };
+ * };
+ */
+static void *fdt_test_build(void)
+{
+	void *fdt = fdt_test_dtb;
+	int err = 0;
+
+	err |= fdt_create(fdt, FDT_TEST_SIZE);
+	err |= fdt_finish_reservemap(fdt);
+	err |= fdt_begin_node(fdt, "");
+	err |= fdt_property_u32(fdt, "#address-cells", 2U);
+	err |= fdt_property_u32(fdt, "#size-cells", 2U);
+
+	err |= fdt_begin_node(fdt, "memory@80000000");
+	FDT_CELLS(fdt, "reg", 0x0U, 0x80000000U, 0x0U, 0x7f000000U,
+		  0x8U, 0x80000000U, 0x1U, 0x80000000U);
+	err |= fdt_property(fdt, "reg-names", "dram0\0dram1", 12);
+	err |= fdt_property_u32(fdt, "numa-node-id", 0x12345678U);
+	FDT_CELLS(fdt, "tag", 0xdeadbeefU, 0xcafef00dU, 0x1U);
+	err |= fdt_property_string(fdt, "label", "system memory");
+	err |= fdt_end_node(fdt);
+
+	err |= fdt_begin_node(fdt, "smb@0,0");
+	err |= fdt_property_u32(fdt, "#address-cells", 2U);
+	err |= fdt_property_u32(fdt, "#size-cells", 1U);
+	FDT_CELLS(fdt, "ranges", 0U, 0U, 0U, 0x08000000U, 0x04000000U,
+		  3U, 0U, 0U, 0x1c000000U, 0x04000000U);
+
+	err |= fdt_begin_node(fdt, "motherboard");
+	err |= fdt_property_u32(fdt, "#address-cells", 2U);
+	err |= fdt_property_u32(fdt, "#size-cells", 1U);
+	err |= fdt_property(fdt, "ranges", NULL, 0);
+
+	err |= fdt_begin_node(fdt, "iofpga@3,00000000");
+	err |= fdt_property_u32(fdt, "#address-cells", 1U);
+	err |= fdt_property_u32(fdt, "#size-cells", 1U);
+	FDT_CELLS(fdt, "ranges", 0U, 3U, 0U, 0x200000U);
+
+	err |= fdt_begin_node(fdt, "uart@a0000");
+	err |= fdt_property_string(fdt, "compatible", "arm,pl011");
+	FDT_CELLS(fdt, "reg", 0xa0000U, 0x1000U);
+	err |= fdt_end_node(fdt);
+
+	err |= fdt_begin_node(fdt, "uart@b0000");
+	err |= fdt_property_string(fdt, "compatible", "arm,pl011");
+	FDT_CELLS(fdt, "reg", 0xb0000U, 0x1000U);
+	err |= fdt_end_node(fdt);
+
+	err |= fdt_end_node(fdt);	/* iofpga */
+	err |= fdt_end_node(fdt);	/* motherboard */
+	err |= fdt_end_node(fdt);	/* smb */
+
+	err |= fdt_begin_node(fdt, "aliases");
+	err |= fdt_property_string(fdt, "serial0", FDT_UART0_PATH);
+	err |= fdt_end_node(fdt);
+
+	err |= fdt_begin_node(fdt, "chosen");
+	err |= fdt_property_string(fdt, "stdout-path", "serial0:115200n8");
+	err |= fdt_end_node(fdt);
+
+	err |= fdt_end_node(fdt);	/* root */
+	err |= fdt_finish(fdt);
+
+	CHECK(err == 0);
+	CHECK(fdt_check_header(fdt) == 0);
+
+	return fdt;
+}
+
+HOST_TEST(fdt_read_cells)
+{
+	void *dtb = fdt_test_build();
+	uint32_t array[8], value;
+	uint64_t value64;
+	int node;
+
+	node = fdt_path_offset(dtb, "/memory@80000000");
+	CHECK(node > 0);
+
+	CHECK(fdt_read_uint32(dtb, node, "numa-node-id", &value) == 0);
+	CHECK(value == 0x12345678U);
+	CHECK(fdt_read_uint32_default(dtb, node, "numa-node-id", 7U) ==
+	      0x12345678U);
+	CHECK(fdt_read_uint32_default(dtb, node, "missing", 7U) == 7U);
+
+	CHECK(fdt_read_uint64(dtb, node, "tag", &value64) == 0);
+	CHECK(value64 == 0xdeadbeefcafef00dULL);
+
+	/* Reading fewer cells than the property holds is fine */
+	memset(array, 0, sizeof(array));
+	CHECK(fdt_read_uint32_array(dtb, node, "reg", 8U, array) == 0);
+	CHECK((array[1] == 0x80000000U) && (array[7] == 0x80000000U));
+	CHECK(fdt_read_uint32_array(dtb, node, "tag", 3U, array) == 0);
+	CHECK(array[2] == 1U);
+
+	/* Reading more is not */
+	CHECK(fdt_read_uint32_array(dtb, node, "tag", 4U, array) ==
+	      -FDT_ERR_BADVALUE);
+	CHECK(fdt_read_uint64(dtb, node, "numa-node-id", &value64) ==
+	      -FDT_ERR_BADVALUE);
+	CHECK(fdt_read_uint32(dtb, node, "missing", &value) ==
+	      -FDT_ERR_NOTFOUND);
+}
+
+HOST_TEST(fdt_read_bytes_string)
+{
+	void *dtb = fdt_test_build();
+	char str[32];
+	uint8_t bytes[8];
+	int node;
+
+	node = fdt_path_offset(dtb, "/memory@80000000");
+	CHECK(node > 0);
+
+	CHECK(fdtw_read_bytes(dtb, node, "tag", 5U, bytes) == 0);
+	CHECK(memcmp(bytes, "\xde\xad\xbe\xef\xca", 5U) == 0);
+	CHECK(fdtw_read_bytes(dtb, node, "tag", 13U, bytes) == -1);
+	CHECK(fdtw_read_bytes(dtb, node, "missing", 1U, bytes) == -1);
+
+	CHECK(fdtw_read_string(dtb, node, "label", str, sizeof(str)) == 0);
+	CHECK(strcmp(str, "system memory") == 0);
+
+	/* Exactly enough room, then one byte short */
+	CHECK(fdtw_read_string(dtb, node, "label", str, 14U) == 0);
+	CHECK(strcmp(str, "system memory") == 0);
+	CHECK(fdtw_read_string(dtb, node, "label", str, 13U) == -1);
+	CHECK(fdtw_read_string(dtb, node, "missing", str, sizeof(str)) == -1);
+}
+
+HOST_TEST(fdt_write_inplace)
+{
+	void *dtb = fdt_test_build();
+	uint32_t value;
+	uint64_t value64;
+	uint8_t bytes[4] = { 1U, 2U, 3U, 4U };
+	uint8_t readback[12];
+	int node;
+
+	node = fdt_path_offset(dtb, "/memory@80000000");
+	CHECK(node > 0);
+
+	value = 0xa5a5a5a5U;
+	CHECK(fdtw_write_inplace_cells(dtb, node, "numa-node-id", 1U,
+				       &value) == 0);
+	CHECK(fdt_read_uint32_default(dtb, node, "numa-node-id", 0U) ==
+	      0xa5a5a5a5U);
+
+	/* The size of a property can't change in place */
+	value64 = 0x0123456789abcdefULL;
+	CHECK(fdtw_write_inplace_cells(dtb, node, "numa-node-id", 2U,
+				       &value64) == -1);
+
+	/* A partial write leaves the rest of the property alone */
+	CHECK(fdtw_write_inplace_bytes(dtb, node, "tag", sizeof(bytes),
+				       bytes) == 0);
+	CHECK(fdtw_read_bytes(dtb, node, "tag", sizeof(readback),
+			      readback) == 0);
+	CHECK(memcmp(readback, "\x01\x02\x03\x04\xca\xfe\xf0\x0d", 8U) == 0);
+	CHECK(fdtw_write_inplace_bytes(dtb, node, "numa-node-id", 5U,
+				       readback) == -1);
+}
+
+HOST_TEST(fdt_reg_props)
+{
+	void *dtb = fdt_test_build();
+	uintptr_t base;
+	size_t size;
+	int node;
+
+	node = fdt_path_offset(dtb, "/memory@80000000");
+	CHECK(node > 0);
+
+	CHECK(fdt_get_reg_props_by_index(dtb, node, 0, &base, &size) == 0);
+	CHECK((base == 0x80000000U) && (size == 0x7f000000U));
+	CHECK(fdt_get_reg_props_by_name(dtb, node, "dram1", &base,
+					&size) == 0);
+	CHECK(base == (uintptr_t)0x880000000ULL);
+	CHECK(size == (size_t)0x180000000ULL);
+	CHECK(fdt_get_reg_props_by_index(dtb, node, 2, &base, &size) ==
+	      -FDT_ERR_BADVALUE);
+	CHECK(fdt_get_reg_props_by_name(dtb, node, "dram2", &base, &size) ==
+	      -FDT_ERR_NOTFOUND);
+
+	/* Cell counts come from the parent node */
+	node = fdt_path_offset(dtb, FDT_UART1_PATH);
+	CHECK(node > 0);
+	CHECK(fdt_get_reg_props_by_index(dtb, node, 0, &base, NULL) == 0);
+	CHECK(base == 0xb0000U);
+	CHECK(fdt_get_reg_props_by_index(dtb, node, 0, NULL, &size) == 0);
+	CHECK(size == 0x1000U);
+}
+
+HOST_TEST(fdt_stdout_node)
+{
+	static uint8_t copy[FDT_TEST_SIZE];
+	void *dtb = fdt_test_build();
+	int node;
+
+	/* Through the alias */
+	CHECK(fdt_get_stdout_node_offset(dtb) ==
+	      fdt_path_offset(dtb, FDT_UART0_PATH));
+
+	/* /secure-chosen takes precedence, and may hold a full path */
+	CHECK(fdt_open_into(dtb, copy, sizeof(copy)) == 0);
+	node = fdt_add_subnode(copy, 0, "secure-chosen");
+	CHECK(node > 0);
+	CHECK(fdt_setprop_string(copy, node, "stdout-path",
+				 FDT_UART1_PATH ":115200n8") == 0);
+	CHECK(fdt_get_stdout_node_offset(copy) ==
+	      fdt_path_offset(copy, FDT_UART1_PATH));
+
+	/* A dangling alias */
+	CHECK(fdt_setprop_string(copy, node, "stdout-path", "serial1") == 0);
+	CHECK(fdt_get_stdout_node_offset(copy) == -FDT_ERR_NOTFOUND);
+}
+
+HOST_TEST(fdt_translate_address)
+{
+	void *dtb = fdt_test_build();
+	int node;
+
+	/* uart@a0000 -> iofpga 3:0xa0000 -> smb 3:0xa0000 -> 0x1c0a0000 */
+	node = fdt_path_offset(dtb, FDT_UART0_PATH);
+	CHECK(node > 0);
+	CHECK(fdtw_translate_address(dtb, node, 0xa0000U) == 0x1c0a0000U);
+
+	node = fdt_path_offset(dtb, FDT_UART1_PATH);
+	CHECK(fdtw_translate_address(dtb, node, 0xb0000U) == 0x1c0b0000U);
+
+	/* Outside of the iofpga window */
+	CHECK(fdtw_translate_address(dtb, node, 0x200000U) == ~0ULL);
+
+	/* Children of the root node are already in the CPU address space */
+	node = fdt_path_offset(dtb, "/memory@80000000");
+	CHECK(fdtw_translate_address(dtb, node, 0x80000000U) == 0x80000000U);
+}
+
+HOST_BENCH(fdt_bench)
+{
+	void *dtb = fdt_test_build();
+	int mem, uart, fail = 0;
+	unsigned long i;
+	uintptr_t base;
+	size_t size;
+	uint64_t start, sum = 0U;
+	char str[32];
+
+	mem = fdt_path_offset(dtb, "/memory@80000000");
+	uart = fdt_path_offset(dtb, FDT_UART0_PATH);
+
+	start = host_time_ns();
+	for (i = 0UL; i < FDT_BENCH_OPS; i++) {
+		sum += fdt_read_uint32_default(dtb, mem, "numa-node-id", 0U);
+	}
+	host_bench_report("fdt_read_uint32_default", FDT_BENCH_OPS,
+			  host_time_ns() - start);
+
+	start = host_time_ns();
+	for (i = 0UL; i < FDT_BENCH_OPS; i++) {
+		fail |= fdtw_read_string(dtb, mem, "label", str, sizeof(str));
+	}
+	host_bench_report("fdtw_read_string", FDT_BENCH_OPS,
+			  host_time_ns() - start);
+
+	start = host_time_ns();
+	for (i = 0UL; i < FDT_BENCH_OPS; i++) {
+		fail |= fdt_get_reg_props_by_name(dtb, mem, "dram1", &base,
+						  &size);
+	}
+	host_bench_report("fdt_get_reg_props_by_name", FDT_BENCH_OPS,
+			  host_time_ns() - start);
+
+	start = host_time_ns();
+	for (i = 0UL; i < FDT_BENCH_OPS; i++) {
+		sum += (uint64_t)fdt_get_stdout_node_offset(dtb);
+	}
+	host_bench_report("fdt_get_stdout_node_offset", FDT_BENCH_OPS,
+			  host_time_ns() - start);
+
+	start = host_time_ns();
+	for (i = 0UL; i < FDT_BENCH_OPS; i++) {
+		sum += fdtw_translate_address(dtb, uart, 0xa0000U);
+	}
+	host_bench_report("fdtw_translate_address", FDT_BENCH_OPS,
+			  host_time_ns() - start);
+
+	CHECK(fail == 0);
+	CHECK(sum != 0U);
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <drivers/partition/gpt.h>
+
+#include "host_tests.h"
+
+#define GPT_BENCH_ENTRIES	128U
+#define GPT_BENCH_PASSES	2000U
+
+/* Fill in a GPT entry the way a disk image stores it, name in UTF-16LE */
+static void gpt_make_entry(gpt_entry_t *gpt_entry, const char *name,
+			   unsigned long long first_lba,
+			   unsigned long long last_lba)
+{
+	size_t i;
+
+	memset(gpt_entry, 0, sizeof(*gpt_entry));
+	memset(gpt_entry->type_uuid, 0xa5, GUID_LEN);
+	memset(gpt_entry->unique_uuid, 0x5a, GUID_LEN);
+	gpt_entry->first_lba = first_lba;
+	gpt_entry->last_lba = last_lba;
+
+	for (i = 0U; (i < EFI_NAMELEN) && (name[i] != '\0'); i++) {
+		gpt_entry->name[i] = (unsigned char)name[i];
+	}
+}
+
+HOST_TEST(gpt_parse_entry)
+{
+	gpt_entry_t gpt_entry;
+	partition_entry_t entry;
+	char name[EFI_NAMELEN + 1];
+
+	gpt_make_entry(&gpt_entry, "fip", 34ULL, 2081ULL);
+	memset(&entry, 0xff, sizeof(entry));
+	CHECK(parse_gpt_entry(&gpt_entry, &entry) == 0);
+	CHECK(strcmp(entry.name, "fip") == 0);
+	CHECK(entry.start == 34ULL * PLAT_PARTITION_BLOCK_SIZE);
+	CHECK(entry.length == 2048ULL * PLAT_PARTITION_BLOCK_SIZE);
+
+	/* The rest of the name is cleared */
+	CHECK(entry.name[EFI_NAMELEN - 1] == '\0');
+
+	/* A one block partition */
+	gpt_make_entry(&gpt_entry, "a", 100ULL, 100ULL);
+	CHECK(parse_gpt_entry(&gpt_entry, &entry) == 0);
+	CHECK(entry.start == 100ULL * PLAT_PARTITION_BLOCK_SIZE);
+	CHECK(entry.length == PLAT_PARTITION_BLOCK_SIZE);
+
+	/* Offsets beyond 4GiB are not truncated */
+	gpt_make_entry(&gpt_entry, "rootfs", 0x100000000ULL, 0x1ffffffffULL);
+	CHECK(parse_gpt_entry(&gpt_entry, &entry) == 0);
+	CHECK(entry.start == 0x100000000ULL * PLAT_PARTITION_BLOCK_SIZE);
+	CHECK(entry.length == 0x100000000ULL * PLAT_PARTITION_BLOCK_SIZE);
+
+	/* A name using all EFI_NAMELEN characters has no terminator */
+	memset(name, 'x', EFI_NAMELEN);
+	name[EFI_NAMELEN] = '\0';
+	gpt_make_entry(&gpt_entry, name, 1ULL, 2ULL);
+	CHECK(parse_gpt_entry(&gpt_entry, &entry) == 0);
+	CHECK(memcmp(entry.name, name, EFI_NAMELEN) == 0);
+}
+
+HOST_TEST(gpt_parse_entry_invalid)
+{
+	gpt_entry_t gpt_entry;
+	partition_entry_t entry;
+
+	/* An unused entry */
+	gpt_make_entry(&gpt_entry, "unused", 0ULL, 0ULL);
+	CHECK(parse_gpt_entry(&gpt_entry, &entry) == -EINVAL);
+
+	/* Characters outside ASCII are rejected, even after the terminator */
+	gpt_make_entry(&gpt_entry, "boot", 1ULL, 8ULL);
+	gpt_entry.name[1] = 0x0430U;
+	CHECK(parse_gpt_entry(&gpt_entry, &entry) == -EINVAL);
+
+	gpt_make_entry(&gpt_entry, "boot", 1ULL, 8ULL);
+	gpt_entry.name[EFI_NAMELEN - 1] = 0x2000U;
+	CHECK(parse_gpt_entry(&gpt_entry, &entry) == -EINVAL);
+}
+
+static gpt_entry_t gpt_bench_entries[GPT_BENCH_ENTRIES];
+
+HOST_BENCH(gpt_bench)
+{
+	partition_entry_t entry;
+	char name[EFI_NAMELEN];
+	unsigned long ops = 0UL;
+	unsigned int i, pass;
+	uint64_t start;
+	int failed = 0;
+
+	for (i = 0U; i < GPT_BENCH_ENTRIES; i++) {
+		(void)snprintf(name, sizeof(name), "partition-%u", i);
+		gpt_make_entry(&gpt_bench_entries[i], name, 34ULL + i * 2048ULL,
+			       34ULL + i * 2048ULL + 2047ULL);
+	}
+
+	start = host_time_ns();
+	for (pass = 0U; pass < GPT_BENCH_PASSES; pass++) {
+		for (i = 0U; i < GPT_BENCH_ENTRIES; i++) {
+			failed |= parse_gpt_entry(&gpt_bench_entries[i],
+						  &entry);
+			ops++;
+		}
+	}
+	host_bench_report("parse_gpt_entry", ops, host_time_ns() - start);
+
+	CHECK(failed == 0);
+}
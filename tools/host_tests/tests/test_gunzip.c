@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tf_gunzip.h>
+#include <zlib.h>
+
+#include "host_tests.h"
+
+#define GZ_WORK_SIZE		(64U * 1024U)
+#define GZ_BENCH_SIZE		(1024U * 1024U)
+#define GZ_BENCH_PASSES		20UL
+
+#define GZ_WINDOW		32768U
+#define GZ_MIN_MATCH		3U
+#define GZ_MAX_MATCH		258U
+#define GZ_HASH_BITS		15U
+#define GZ_STORED_MAX		65535U
+
+/*
+ * The tests need gzip streams, and the tree only has the inflate side of zlib.
+ * This is a minimal deflate encoder: greedy LZ77 matching emitted with the
+ * fixed Huffman codes of RFC 1951, or stored blocks, in a gzip wrapper.
+ */
+struct gz_writer {
+	uint8_t *buf;
+	size_t len;
+	uint32_t bits;
+	unsigned int nbits;
+};
+
+static const uint16_t gz_len_base[29] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t gz_len_extra[29] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t gz_dist_base[30] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289,
+	16385, 24577
+};
+static const uint8_t gz_dist_extra[30] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/* Values are packed from the least significant bit */
+static void gz_put_bits(struct gz_writer *w, uint32_t value, unsigned int n)
+{
+	w->bits |= value << w->nbits;
+	w->nbits += n;
+	while (w->nbits >= 8U) {
+		w->buf[w->len++] = (uint8_t)w->bits;
+		w->bits >>= 8;
+		w->nbits -= 8U;
+	}
+}
+
+/* Huffman codes are packed from the most significant bit */
+static void gz_put_code(struct gz_writer *w, uint32_t code, unsigned int n)
+{
+	while (n-- > 0U) {
+		gz_put_bits(w, (code >> n) & 1U, 1U);
+	}
+}
+
+static void gz_flush_bits(struct gz_writer *w)
+{
+	if (w->nbits > 0U) {
+		gz_put_bits(w, 0U, 8U - w->nbits);
+	}
+}
+
+static void gz_put_le32(struct gz_writer *w, uint32_t value)
+{
+	unsigned int i;
+
+	for (i = 0U; i < 4U; i++) {
+		w->buf[w->len++] = (uint8_t)(value >> (i * 8U));
+	}
+}
+
+static void gz_put_symbol(struct gz_writer *w, unsigned int sym)
+{
+	if (sym < 144U) {
+		gz_put_code(w, 0x30U + sym, 8U);
+	} else if (sym < 256U) {
+		gz_put_code(w, 0x190U + (sym - 144U), 9U);
+	} else if (sym < 280U) {
+		gz_put_code(w, sym - 256U, 7U);
+	} else {
+		gz_put_code(w, 0xc0U + (sym - 280U), 8U);
+	}
+}
+
+static void gz_put_match(struct gz_writer *w, unsigned int len,
+			 unsigned int dist)
+{
+	unsigned int i;
+
+	for (i = 28U; gz_len_base[i] > len; i--) {
+	}
+	gz_put_symbol(w, 257U + i);
+	gz_put_bits(w, len - gz_len_base[i], gz_len_extra[i]);
+
+	for (i = 29U; gz_dist_base[i] > dist; i--) {
+	}
+	gz_put_code(w, i, 5U);
+	gz_put_bits(w, dist - gz_dist_base[i], gz_dist_extra[i]);
+}
+
+static unsigned int gz_hash(const uint8_t *p)
+{
+	uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+		     ((uint32_t)p[2] << 16);
+
+	return (v * 0x9e3779b1U) >> (32U - GZ_HASH_BITS);
+}
+
+static void gz_deflate_fixed(struct gz_writer *w, const uint8_t *in,
+			     size_t len)
+{
+	static int32_t head[1U << GZ_HASH_BITS];
+	size_t pos = 0U;
+
+	memset(head, 0xff, sizeof(head));
+
+	/* BFINAL, BTYPE = fixed Huffman */
+	gz_put_bits(w, 1U, 1U);
+	gz_put_bits(w, 1U, 2U);
+
+	while (pos < len) {
+		size_t best = 0U, dist = 0U;
+
+		if ((len - pos) >= GZ_MIN_MATCH) {
+			unsigned int h = gz_hash(&in[pos]);
+			int32_t cand = head[h];
+
+			head[h] = (int32_t)pos;
+			if ((cand >= 0) && ((pos - (size_t)cand) <= GZ_WINDOW)) {
+				size_t max = len - pos, n = 0U;
+
+				if (max > GZ_MAX_MATCH) {
+					max = GZ_MAX_MATCH;
+				}
+				while ((n < max) && (in[cand + n] == in[pos + n])) {
+					n++;
+				}
+				best = n;
+				dist = pos - (size_t)cand;
+			}
+		}
+
+		if (best >= GZ_MIN_MATCH) {
+			gz_put_match(w, (unsigned int)best, (unsigned int)dist);
+			pos += best;
+		} else {
+			gz_put_symbol(w, in[pos]);
+			pos++;
+		}
+	}
+
+	gz_put_symbol(w, 256U);
+	gz_flush_bits(w);
+}
+
+static void gz_deflate_stored(struct gz_writer *w, const uint8_t *in,
+			      size_t len)
+{
+	do {
+		size_t n = (len > GZ_STORED_MAX) ? GZ_STORED_MAX : len;
+
+		/* BFINAL, BTYPE = stored, then LEN and NLEN on a byte boundary */
+		gz_put_bits(w, (n == len) ? 1U : 0U, 1U);
+		gz_put_bits(w, 0U, 2U);
+		gz_flush_bits(w);
+		gz_put_bits(w, (uint32_t)n, 16U);
+		gz_put_bits(w, (uint32_t)~n & 0xffffU, 16U);
+		memcpy(&w->buf[w->len], in, n);
+		w->len += n;
+		in += n;
+		len -= n;
+	} while (len > 0U);
+}
+
+/* Returns a malloc'ed gzip stream of in[], its size in *gz_len */
+static uint8_t *gz_compress(const uint8_t *in, size_t len, bool stored,
+			    size_t *gz_len)
+{
+	static const uint8_t header[10] = {
+		0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff
+	};
+	struct gz_writer w = { 0 };
+
+	/* Fixed codes take at most 9 bits per byte */
+	w.buf = malloc(len + (len / 7U) + (len / GZ_STORED_MAX + 1U) * 5U +
+		       64U);
+	memcpy(w.buf, header, sizeof(header));
+	w.len = sizeof(header);
+
+	if (stored) {
+		gz_deflate_stored(&w, in, len);
+	} else {
+		gz_deflate_fixed(&w, in, len);
+	}
+
+	gz_put_le32(&w, (uint32_t)crc32(0UL, in, (uInt)len));
+	gz_put_le32(&w, (uint32_t)len);
+
+	*gz_len = w.len;
+
+	return w.buf;
+}
+
+/* Text-like data with plenty of repeats, mixed with noise */
+static void gz_fill(uint8_t *buf, size_t len, uint32_t seed)
+{
+	static const char *const words[] = {
+		"secure ", "monitor ", "world ", "trusted ", "firmware ",
+		"boot ", "image ", "partition ", "el3 ", "\n"
+	};
+	uint32_t rng = seed;
+	size_t pos = 0U;
+
+	while (pos < len) {
+		const char *word;
+		size_t n;
+
+		rng = rng * 1103515245U + 12345U;
+		word = words[(rng >> 16) % 10U];
+		if (((rng >> 8) & 0xfU) == 0U) {
+			buf[pos++] = (uint8_t)(rng >> 24);
+			continue;
+		}
+		n = strlen(word);
+		if (n > (len - pos)) {
+			n = len - pos;
+		}
+		memcpy(&buf[pos], word, n);
+		pos += n;
+	}
+}
+
+static uint8_t gz_work[GZ_WORK_SIZE];
+
+static int gz_run(const uint8_t *gz, size_t gz_len, uint8_t *out,
+		  size_t out_len, size_t work_len, size_t *in_used,
+		  size_t *out_used)
+{
+	uintptr_t in_buf = (uintptr_t)gz, out_buf = (uintptr_t)out;
+	int ret;
+
+	ret = gunzip(&in_buf, gz_len, &out_buf, out_len, (uintptr_t)gz_work,
+		     work_len);
+	*in_used = in_buf - (uintptr_t)gz;
+	*out_used = out_buf - (uintptr_t)out;
+
+	return ret;
+}
+
+static void gz_check_roundtrip(const uint8_t *data, size_t len, bool stored)
+{
+	uint8_t *gz, *out;
+	size_t gz_len, in_used, out_used;
+
+	gz = gz_compress(data, len, stored, &gz_len);
+	out = malloc(len + 16U);
+	memset(out, 0xa5, len + 16U);
+
+	CHECK(gz_run(gz, gz_len, out, len + 16U, sizeof(gz_work), &in_used,
+		     &out_used) == 0);
+	CHECK(in_used == gz_len);
+	CHECK(out_used == len);
+	CHECK(memcmp(out, data, len) == 0);
+	CHECK(out[len] == 0xa5U);
+
+	free(out);
+	free(gz);
+}
+
+HOST_TEST(gunzip_roundtrip)
+{
+	static uint8_t data[200000];
+	size_t i;
+
+	/* Single bytes, and data matching itself at distance 1 */
+	gz_check_roundtrip((const uint8_t *)"x", 1U, false);
+	memset(data, 0, sizeof(data));
+	gz_check_roundtrip(data, sizeof(data), false);
+
+	gz_fill(data, sizeof(data), 1U);
+	gz_check_roundtrip(data, sizeof(data), false);
+	gz_check_roundtrip(data, sizeof(data), true);
+
+	/* Incompressible data, over several stored blocks */
+	for (i = 0U; i < sizeof(data); i++) {
+		data[i] = (uint8_t)((i * 2654435761U) >> 13);
+	}
+	gz_check_roundtrip(data, sizeof(data), false);
+	gz_check_roundtrip(data, sizeof(data), true);
+}
+
+HOST_TEST(gunzip_errors)
+{
+	static uint8_t data[50000], out[sizeof(data)];
+	uint8_t *gz;
+	size_t gz_len, in_used, out_used;
+
+	gz_fill(data, sizeof(data), 2U);
+	gz = gz_compress(data, sizeof(data), false, &gz_len);
+
+	/* Output buffer too small */
+	CHECK(gz_run(gz, gz_len, out, sizeof(data) - 1U, sizeof(gz_work),
+		     &in_used, &out_used) == -EIO);
+	CHECK(out_used == sizeof(data) - 1U);
+
+	/* Truncated input */
+	CHECK(gz_run(gz, gz_len - 1U, out, sizeof(out), sizeof(gz_work),
+		     &in_used, &out_used) == -EIO);
+
+	/*
+	 * Not enough workspace for the inflate state. The 32KiB window is only
+	 * allocated when inflate() returns before the end of the stream, so a
+	 * complete decode fits in much less.
+	 */
+	CHECK(gz_run(gz, gz_len, out, sizeof(out), 1024U, &in_used,
+		     &out_used) == -ENOMEM);
+	CHECK(gz_run(gz, gz_len, out, sizeof(out) - 1U, 8192U, &in_used,
+		     &out_used) == -ENOMEM);
+	CHECK(gz_run(gz, gz_len, out, sizeof(out), 8192U, &in_used,
+		     &out_used) == 0);
+
+	/* Corrupted CRC */
+	gz[gz_len - 8U] ^= 1U;
+	CHECK(gz_run(gz, gz_len, out, sizeof(out), sizeof(gz_work), &in_used,
+		     &out_used) == -EIO);
+	gz[gz_len - 8U] ^= 1U;
+
+	/* Not a gzip stream */
+	gz[0] = 0x78U;
+	CHECK(gz_run(gz, gz_len, out, sizeof(out), sizeof(gz_work), &in_used,
+		     &out_used) == -EIO);
+	gz[0] = 0x1fU;
+
+	CHECK(gz_run(gz, gz_len, out, sizeof(out), sizeof(gz_work), &in_used,
+		     &out_used) == 0);
+	CHECK(memcmp(out, data, sizeof(data)) == 0);
+
+	free(gz);
+}
+
+static void gz_bench(const char *what, const uint8_t *data, bool stored)
+{
+	static uint8_t out[GZ_BENCH_SIZE];
+	size_t gz_len, in_used, out_used;
+	unsigned long i;
+	uint8_t *gz;
+	uint64_t start;
+	int ret = 0;
+
+	gz = gz_compress(data, GZ_BENCH_SIZE, stored, &gz_len);
+
+	start = host_time_ns();
+	for (i = 0UL; i < GZ_BENCH_PASSES; i++) {
+		ret |= gz_run(gz, gz_len, out, sizeof(out), sizeof(gz_work),
+			      &in_used, &out_used);
+	}
+	host_bench_report(what, GZ_BENCH_PASSES, host_time_ns() - start);
+
+	CHECK(ret == 0);
+	CHECK(memcmp(out, data, GZ_BENCH_SIZE) == 0);
+
+	free(gz);
+}
+
+HOST_BENCH(gunzip_bench)
+{
+	static uint8_t data[GZ_BENCH_SIZE];
+
+	gz_fill(data, sizeof(data), 3U);
+	gz_bench("gunzip 1MiB text, fixed codes", data, false);
+	gz_bench("gunzip 1MiB text, stored", data, true);
+}
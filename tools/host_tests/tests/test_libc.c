@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "host_tests.h"
+
+/*
+ * Functions of the firmware C library, renamed as listed in shim/tf_libc.syms.
+ * The tests check them against those of the host C library.
+ */
+void *tf_memchr(const void *src, int c, size_t len);
+int tf_memcmp(const void *s1, const void *s2, size_t len);
+void *tf_memcpy(void *dst, const void *src, size_t len);
+void *tf_memmove(void *dst, const void *src, size_t len);
+void *tf_memrchr(const void *src, int c, size_t len);
+void *tf_memset(void *dst, int val, size_t count);
+int tf_printf(const char *fmt, ...);
+int tf_snprintf(char *s, size_t n, const char *fmt, ...);
+char *tf_strchr(const char *s, int c);
+int tf_strcmp(const char *s1, const char *s2);
+size_t tf_strlen(const char *s);
+int tf_strncmp(const char *s1, const char *s2, size_t n);
+size_t tf_strnlen(const char *s, size_t maxlen);
+char *tf_strrchr(const char *p, int ch);
+char *tf_strtok_r(char *s, const char *delim, char **last);
+long tf_strtol(const char *nptr, char **endptr, int base);
+long long tf_strtoll(const char *nptr, char **endptr, int base);
+unsigned long tf_strtoul(const char *nptr, char **endptr, int base);
+unsigned long long tf_strtoull(const char *nptr, char **endptr, int base);
+
+#define LIBC_BUF_SIZE		512U
+#define LIBC_GUARD		0xa5U
+#define LIBC_ITERATIONS		20000U
+
+static uint64_t libc_rng = 1U;
+
+/* xorshift64*, so that the tests are reproducible */
+static uint64_t libc_rand(void)
+{
+	libc_rng ^= libc_rng >> 12;
+	libc_rng ^= libc_rng << 25;
+	libc_rng ^= libc_rng >> 27;
+
+	return libc_rng * 0x2545f4914f6cdd1dULL;
+}
+
+static void libc_fill(unsigned char *buf, size_t len)
+{
+	size_t i;
+
+	for (i = 0U; i < len; i++) {
+		/* Few distinct values, so that searches find something */
+		buf[i] = (unsigned char)('a' + (libc_rand() % 8U));
+	}
+}
+
+static int sign(int v)
+{
+	return (v > 0) - (v < 0);
+}
+
+/*
+ * Copy, move and set random ranges of a buffer, at every alignment, and check
+ * the result and the bytes around the range against the host C library.
+ */
+HOST_TEST(libc_mem_copy_set)
+{
+	static unsigned char src[LIBC_BUF_SIZE];
+	static unsigned char tf_buf[LIBC_BUF_SIZE], host_buf[LIBC_BUF_SIZE];
+	size_t dst_off, src_off, len;
+	unsigned int i;
+	void *ret;
+
+	for (i = 0U; i < LIBC_ITERATIONS; i++) {
+		libc_fill(src, sizeof(src));
+		memset(tf_buf, LIBC_GUARD, sizeof(tf_buf));
+		memset(host_buf, LIBC_GUARD, sizeof(host_buf));
+
+		len = libc_rand() % (LIBC_BUF_SIZE / 2U);
+		dst_off = libc_rand() % (LIBC_BUF_SIZE / 2U);
+		src_off = libc_rand() % (LIBC_BUF_SIZE / 2U);
+
+		switch (i % 3U) {
+		case 0U:
+			ret = tf_memcpy(tf_buf + dst_off, src + src_off, len);
+			memcpy(host_buf + dst_off, src + src_off, len);
+			break;
+		case 1U:
+			ret = tf_memset(tf_buf + dst_off, src[0], len);
+			memset(host_buf + dst_off, src[0], len);
+			break;
+		default:
+			/* Overlapping moves, in both directions */
+			memcpy(tf_buf, src, sizeof(src));
+			memcpy(host_buf, src, sizeof(src));
+			ret = tf_memmove(tf_buf + dst_off, tf_buf + src_off,
+					 len);
+			memmove(host_buf + dst_off, host_buf + src_off, len);
+			break;
+		}
+
+		CHECK(ret == tf_buf + dst_off);
+		if (memcmp(tf_buf, host_buf, sizeof(tf_buf)) != 0) {
+			printf("    op %u dst %zu src %zu len %zu\n", i % 3U,
+			       dst_off, src_off, len);
+			CHECK(memcmp(tf_buf, host_buf, sizeof(tf_buf)) == 0);
+			return;
+		}
+	}
+}
+
+HOST_TEST(libc_mem_compare_search)
+{
+	static unsigned char a[LIBC_BUF_SIZE], b[LIBC_BUF_SIZE];
+	size_t off, len;
+	unsigned int i;
+	int c;
+
+	for (i = 0U; i < LIBC_ITERATIONS; i++) {
+		libc_fill(a, sizeof(a));
+		memcpy(b, a, sizeof(a));
+
+		len = libc_rand() % (LIBC_BUF_SIZE / 2U);
+		off = libc_rand() % (LIBC_BUF_SIZE / 2U);
+		c = 'a' + (int)(libc_rand() % 10U);
+
+		/* Differ at a random place, or not at all */
+		if ((len != 0U) && ((i % 4U) != 0U)) {
+			b[off + (libc_rand() % len)] = (unsigned char)c;
+		}
+
+		CHECK(sign(tf_memcmp(a + off, b + off, len)) ==
+		      sign(memcmp(a + off, b + off, len)));
+		CHECK(tf_memchr(a + off, c, len) == memchr(a + off, c, len));
+		CHECK(tf_memrchr(a + off, c, len) == memrchr(a + off, c, len));
+	}
+
+	/* Bytes compare as unsigned char */
+	a[0] = 0x80U;
+	b[0] = 0x7fU;
+	CHECK(tf_memcmp(a, b, 1U) > 0);
+	CHECK(tf_memchr(a, 0x180, 1U) == a);
+}
+
+HOST_TEST(libc_str)
+{
+	static const char *const strs[] = {
+		"", "a", "ab", "abc", "abd", "abcd", "b", "hello, world",
+		"\x80", "\x7f", "abc\x80",
+	};
+	const size_t n = sizeof(strs) / sizeof(strs[0]);
+	char tf_buf[8], host_buf[8], str_buf[64];
+	size_t i, j, k;
+	int c;
+
+	for (i = 0U; i < n; i++) {
+		CHECK(tf_strlen(strs[i]) == strlen(strs[i]));
+
+		for (k = 0U; k < 6U; k++) {
+			CHECK(tf_strnlen(strs[i], k) == strnlen(strs[i], k));
+		}
+
+		for (c = 0; c < 0x100; c++) {
+			CHECK(tf_strchr(strs[i], c) == strchr(strs[i], c));
+			CHECK(tf_strrchr(strs[i], c) == strrchr(strs[i], c));
+		}
+
+		for (j = 0U; j < n; j++) {
+			CHECK(sign(tf_strcmp(strs[i], strs[j])) ==
+			      sign(strcmp(strs[i], strs[j])));
+
+			for (k = 0U; k < 5U; k++) {
+				CHECK(sign(tf_strncmp(strs[i], strs[j], k)) ==
+				      sign(strncmp(strs[i], strs[j], k)));
+			}
+		}
+	}
+
+	/* strlen() at every alignment of the start and of the end */
+	for (i = 0U; i < 16U; i++) {
+		for (j = 0U; j < 40U; j++) {
+			memset(str_buf, 'x', sizeof(str_buf));
+			str_buf[i + j] = '\0';
+			CHECK(tf_strlen(str_buf + i) == j);
+		}
+	}
+
+	/*
+	 * strlcpy() and strlcat() are those of the firmware, see
+	 * shim/include/string.h. They truncate and return the length they tried.
+	 */
+	CHECK(strlcpy(tf_buf, "hello, world", sizeof(tf_buf)) == 12U);
+	CHECK(strcmp(tf_buf, "hello, ") == 0);
+	CHECK(strlcpy(tf_buf, "abc", sizeof(tf_buf)) == 3U);
+	CHECK(strcmp(tf_buf, "abc") == 0);
+	CHECK(strlcat(tf_buf, "def", sizeof(tf_buf)) == 6U);
+	CHECK(strcmp(tf_buf, "abcdef") == 0);
+	CHECK(strlcat(tf_buf, "ghi", sizeof(tf_buf)) == 9U);
+	CHECK(strcmp(tf_buf, "abcdefg") == 0);
+	CHECK(strlcpy(tf_buf, "xyz", 0U) == 3U);
+	CHECK(strcmp(tf_buf, "abcdefg") == 0);
+
+	/* strtok_r() */
+	strcpy(tf_buf, ",a,,bc,");
+	strcpy(host_buf, ",a,,bc,");
+	{
+		char *tf_last, *host_last;
+		char *tf_tok = tf_strtok_r(tf_buf, ",", &tf_last);
+		char *host_tok = strtok_r(host_buf, ",", &host_last);
+
+		while ((tf_tok != NULL) || (host_tok != NULL)) {
+			CHECK((tf_tok != NULL) && (host_tok != NULL));
+			if ((tf_tok == NULL) || (host_tok == NULL)) {
+				break;
+			}
+			CHECK(tf_tok - tf_buf == host_tok - host_buf);
+			CHECK(strcmp(tf_tok, host_tok) == 0);
+			tf_tok = tf_strtok_r(NULL, ",", &tf_last);
+			host_tok = strtok_r(NULL, ",", &host_last);
+		}
+	}
+}
+
+HOST_TEST(libc_strtol)
+{
+	static const char *const strs[] = {
+		"0", "1", "-1", "+1", "  42", "\t\n-42xyz", "0x1f", "0X1F",
+		"0x", "0xg", "017", "08", "z", "Zz", "", "-", " +",
+		"2147483647", "2147483648", "-2147483648", "-2147483649",
+		"4294967295", "4294967296",
+		"9223372036854775807", "9223372036854775808",
+		"-9223372036854775808", "-9223372036854775809",
+		"18446744073709551615", "18446744073709551616",
+		"-18446744073709551615", "0xffffffffffffffff",
+		"0x10000000000000000", "123456789012345678901234567890",
+	};
+	static const int bases[] = { 0, 2, 8, 10, 16, 36 };
+	char *tf_end, *host_end;
+	size_t i, j;
+
+	for (i = 0U; i < sizeof(strs) / sizeof(strs[0]); i++) {
+		for (j = 0U; j < sizeof(bases) / sizeof(bases[0]); j++) {
+			CHECK(tf_strtol(strs[i], &tf_end, bases[j]) ==
+			      strtol(strs[i], &host_end, bases[j]));
+			CHECK(tf_end == host_end);
+			CHECK(tf_strtoll(strs[i], &tf_end, bases[j]) ==
+			      strtoll(strs[i], &host_end, bases[j]));
+			CHECK(tf_end == host_end);
+			CHECK(tf_strtoul(strs[i], &tf_end, bases[j]) ==
+			      strtoul(strs[i], &host_end, bases[j]));
+			CHECK(tf_end == host_end);
+			CHECK(tf_strtoull(strs[i], &tf_end, bases[j]) ==
+			      strtoull(strs[i], &host_end, bases[j]));
+			CHECK(tf_end == host_end);
+		}
+	}
+}
+
+/* Check that snprintf() formats the arguments like the host one */
+#define CHECK_SNPRINTF(_size, ...)					\
+	do {								\
+		char _tf[_size], _host[_size];				\
+		/* Hide the size, truncation is tested on purpose */	\
+		volatile size_t _n = (_size);				\
+		int _tf_ret, _host_ret;					\
+									\
+		memset(_tf, LIBC_GUARD, sizeof(_tf));			\
+		memset(_host, LIBC_GUARD, sizeof(_host));		\
+		_tf_ret = tf_snprintf(_tf, _n, __VA_ARGS__);		\
+		_host_ret = snprintf(_host, _n, __VA_ARGS__);		\
+		if ((_tf_ret != _host_ret) ||				\
+		    (memcmp(_tf, _host, sizeof(_tf)) != 0)) {		\
+			printf("    \"%s\" vs \"%s\"\n", _tf, _host);	\
+		}							\
+		CHECK(_tf_ret == _host_ret);				\
+		CHECK(memcmp(_tf, _host, sizeof(_tf)) == 0);		\
+	} while (false)
+
+HOST_TEST(libc_snprintf)
+{
+	int v = 1234;
+
+	CHECK_SNPRINTF(64, "plain text");
+	CHECK_SNPRINTF(64, "%d %i %u", -42, 42, 42U);
+	CHECK_SNPRINTF(64, "%x %X %o %#x %#X %#o", 0xbeefU, 0xbeefU, 8U,
+		       0xbeefU, 0xbeefU, 8U);
+	CHECK_SNPRINTF(64, "%#x %#o", 0U, 0U);
+	CHECK_SNPRINTF(64, "[%5d] [%-5d] [%05d] [%+d] [% d]", 42, 42, 42, 42,
+		       42);
+	CHECK_SNPRINTF(64, "[%05d] [%+05d] [%-+5d] [% 05d]", -42, 42, 42, 42);
+	CHECK_SNPRINTF(64, "[%.3d] [%8.3d] [%-8.3x] [%.0d] [%.0x]", 7, -7, 7U,
+		       0, 0U);
+	CHECK_SNPRINTF(64, "[%*d] [%-*d] [%*d] [%.*d]", 6, 1, 6, 1, -6, 1, 4,
+		       1);
+	CHECK_SNPRINTF(64, "%hhd %hhu %hd %hu", 0x1ff, 0x1ffU, 0x1ffff,
+		       0x1ffffU);
+	CHECK_SNPRINTF(64, "%ld %lu %lx", -1L, ~0UL, ~0UL);
+	CHECK_SNPRINTF(64, "%lld %llu %llx", -1LL, ~0ULL, ~0ULL);
+	CHECK_SNPRINTF(64, "%lld %lld", (long long)(-9223372036854775807LL - 1),
+		       9223372036854775807LL);
+	CHECK_SNPRINTF(64, "%jd %zu %zd %td", (intmax_t)-5, (size_t)5,
+		       (ssize_t)-5, (ptrdiff_t)-5);
+	CHECK_SNPRINTF(64, "%p %p", (void *)&v, (void *)0x1000);
+	CHECK_SNPRINTF(64, "[%s] [%8s] [%-8s] [%.2s] [%8.2s]", "abc", "abc",
+		       "abc", "abc", "abc");
+	CHECK_SNPRINTF(64, "[%c] [%3c] [%-3c] [%%]", 'x', 'y', 'z');
+
+	/* Truncation, with the count of the whole output returned */
+	CHECK_SNPRINTF(8, "0123456789");
+	CHECK_SNPRINTF(8, "%d-%d-%d", 1234, 5678, 9012);
+	CHECK_SNPRINTF(1, "%s", "abc");
+	CHECK(tf_snprintf(NULL, 0U, "%d", v) == 4);
+}
+
+/* Output of printf(), which goes through console_write() */
+static char libc_console[1024];
+static size_t libc_console_len;
+static unsigned int libc_console_writes;
+
+int console_write(const char *buf, size_t len)
+{
+	CHECK(libc_console_len + len <= sizeof(libc_console));
+	if (libc_console_len + len <= sizeof(libc_console)) {
+		memcpy(libc_console + libc_console_len, buf, len);
+		libc_console_len += len;
+	}
+	libc_console_writes++;
+
+	return (int)len;
+}
+
+HOST_TEST(libc_printf)
+{
+	char expected[512];
+	int ret;
+
+	libc_console_len = 0U;
+	libc_console_writes = 0U;
+	ret = tf_printf("%s %d\n", "short", 1);
+	CHECK(ret == 8);
+	CHECK(libc_console_len == 8U);
+	CHECK(memcmp(libc_console, "short 1\n", 8U) == 0);
+	/* The output is written out at once */
+	CHECK(libc_console_writes == 1U);
+
+	/* Longer output than the buffer on the stack is written in chunks */
+	libc_console_len = 0U;
+	libc_console_writes = 0U;
+	ret = tf_printf("%200s|%-100d|%s\n", "right", 42, "end");
+	snprintf(expected, sizeof(expected), "%200s|%-100d|%s\n", "right", 42,
+		 "end");
+	CHECK(ret == (int)strlen(expected));
+	CHECK(libc_console_len == strlen(expected));
+	CHECK(memcmp(libc_console, expected, strlen(expected)) == 0);
+	CHECK(libc_console_writes > 1U);
+}
+
+/* Called through pointers so that the compiler can't elide them */
+static void *(*volatile host_memcpy)(void *, const void *, size_t) = memcpy;
+static void *(*volatile host_memset)(void *, int, size_t) = memset;
+static size_t (*volatile host_strlen)(const char *) = strlen;
+
+static void libc_bench_copy(const char *what, bool tf, size_t len,
+			    size_t misalign)
+{
+	static unsigned char src[8192], dst[8192];
+	unsigned long ops = 4000000UL / (len + 16U);
+	unsigned long i;
+	uint64_t start;
+
+	start = host_time_ns();
+	for (i = 0UL; i < ops; i++) {
+		if (tf) {
+			tf_memcpy(dst + misalign, src, len);
+		} else {
+			host_memcpy(dst + misalign, src, len);
+		}
+	}
+	host_bench_report(what, ops, host_time_ns() - start);
+}
+
+static void libc_bench_set(const char *what, bool tf, size_t len)
+{
+	static unsigned char dst[8192];
+	unsigned long ops = 4000000UL / (len + 16U);
+	unsigned long i;
+	uint64_t start;
+
+	start = host_time_ns();
+	for (i = 0UL; i < ops; i++) {
+		if (tf) {
+			tf_memset(dst, (int)i, len);
+		} else {
+			host_memset(dst, (int)i, len);
+		}
+	}
+	host_bench_report(what, ops, host_time_ns() - start);
+}
+
+HOST_BENCH(libc_bench)
+{
+	static char str[257];
+	char buf[128];
+	unsigned long ops, i;
+	uint64_t start;
+	size_t sum = 0U;
+
+	libc_bench_copy("tf memcpy 64", true, 64U, 0U);
+	libc_bench_copy("host memcpy 64", false, 64U, 0U);
+	libc_bench_copy("tf memcpy 4096", true, 4096U, 0U);
+	libc_bench_copy("host memcpy 4096", false, 4096U, 0U);
+	libc_bench_copy("tf memcpy 4096 misaligned", true, 4096U, 3U);
+	libc_bench_copy("host memcpy 4096 misaligned", false, 4096U, 3U);
+	libc_bench_set("tf memset 4096", true, 4096U);
+	libc_bench_set("host memset 4096", false, 4096U);
+
+	memset(str, 'x', sizeof(str) - 1U);
+	ops = 200000UL;
+	start = host_time_ns();
+	for (i = 0UL; i < ops; i++) {
+		sum += tf_strlen(str);
+	}
+	host_bench_report("tf strlen 256", ops, host_time_ns() - start);
+	start = host_time_ns();
+	for (i = 0UL; i < ops; i++) {
+		sum += host_strlen(str);
+	}
+	host_bench_report("host strlen 256", ops, host_time_ns() - start);
+	CHECK(sum == 2U * ops * 256U);
+
+	/* A typical log message */
+	ops = 500000UL;
+	start = host_time_ns();
+	for (i = 0UL; i < ops; i++) {
+		tf_snprintf(buf, sizeof(buf), "BL31: %s 0x%016llx-0x%lx %u\n",
+			    "region", (unsigned long long)i, i, (unsigned int)i);
+	}
+	host_bench_report("tf snprintf", ops, host_time_ns() - start);
+
+	start = host_time_ns();
+	for (i = 0UL; i < ops; i++) {
+		sum += tf_strtoul("0x80000000", NULL, 0);
+	}
+	host_bench_report("tf strtoul", ops, host_time_ns() - start);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <pthread.h>
+
+#include <lib/rwlock.h>
+
+#include "host_tests.h"
+
+#define RW_READERS		3
+#define RW_WRITERS		2
+#define RW_ITERATIONS		100000UL
+
+#define RW_WRITER		(1U << RWLOCK_WRITER_SHIFT)
+
+/* Writers keep b equal to ~a, so a reader which sees a torn update notices */
+static struct {
+	volatile unsigned long a;
+	volatile unsigned long b;
+} rw_data;
+
+static rwlock_t rw_lock;
+static volatile bool rw_done;
+static unsigned long rw_torn;
+
+HOST_TEST(rwlock_states)
+{
+	rwlock_t lock = { 0 };
+
+	read_lock(&lock);
+	CHECK(lock.lock == 1U);
+	read_lock(&lock);
+	CHECK(lock.lock == 2U);
+	read_unlock(&lock);
+	read_unlock(&lock);
+	CHECK(lock.lock == 0U);
+
+	write_lock(&lock);
+	CHECK(lock.lock == RW_WRITER);
+	write_unlock(&lock);
+	CHECK(lock.lock == 0U);
+}
+
+static void *rw_reader(void *arg)
+{
+	unsigned long a, b;
+
+	(void)arg;
+
+	while (!rw_done) {
+		read_lock(&rw_lock);
+		CHECK((rw_lock.lock & RW_WRITER) == 0U);
+		a = rw_data.a;
+		b = rw_data.b;
+		read_unlock(&rw_lock);
+
+		if (b != ~a) {
+			__atomic_fetch_add(&rw_torn, 1UL, __ATOMIC_RELAXED);
+		}
+	}
+
+	return NULL;
+}
+
+static void *rw_writer(void *arg)
+{
+	unsigned long i;
+
+	(void)arg;
+
+	for (i = 0UL; i < RW_ITERATIONS; i++) {
+		write_lock(&rw_lock);
+		CHECK(rw_lock.lock == RW_WRITER);
+		rw_data.a = rw_data.a + 1UL;
+		rw_data.b = ~rw_data.a;
+		write_unlock(&rw_lock);
+	}
+
+	return NULL;
+}
+
+HOST_TEST(rwlock_concurrent)
+{
+	pthread_t readers[RW_READERS], writers[RW_WRITERS];
+	unsigned int i;
+
+	rw_lock.lock = 0U;
+	rw_data.a = 0UL;
+	rw_data.b = ~0UL;
+
+	for (i = 0U; i < RW_READERS; i++) {
+		CHECK(pthread_create(&readers[i], NULL, rw_reader, NULL) == 0);
+	}
+	for (i = 0U; i < RW_WRITERS; i++) {
+		CHECK(pthread_create(&writers[i], NULL, rw_writer, NULL) == 0);
+	}
+
+	for (i = 0U; i < RW_WRITERS; i++) {
+		pthread_join(writers[i], NULL);
+	}
+	rw_done = true;
+	for (i = 0U; i < RW_READERS; i++) {
+		pthread_join(readers[i], NULL);
+	}
+
+	CHECK(rw_torn == 0UL);
+	CHECK(rw_data.a == (RW_WRITERS * RW_ITERATIONS));
+	CHECK(rw_lock.lock == 0U);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <pthread.h>
+
+#include <lib/seqlock.h>
+
+#include "host_tests.h"
+
+#define SEQ_READERS		3
+#define SEQ_WRITERS		3
+#define SEQ_ITERATIONS		200000UL
+
+/*
+ * Data protected by the lock under test. Writers keep b equal to ~a, so a
+ * reader which sees a torn update notices it.
+ */
+static struct {
+	volatile unsigned long a;
+	volatile unsigned long b;
+} seq_data;
+
+static seqcount_t seq_count;
+static seqlock_t seq_lock;
+static volatile bool seq_done;
+static unsigned long seq_torn;
+
+HOST_TEST(seqcount_sequence)
+{
+	seqcount_t sc = { 0 };
+	uint32_t seq;
+
+	seq = read_seqcount_begin(&sc);
+	CHECK((seq & 1U) == 0U);
+	CHECK(!read_seqcount_retry(&sc, seq));
+
+	/* A write in progress makes the count odd */
+	write_seqcount_begin(&sc);
+	CHECK((sc.seq & 1U) != 0U);
+	CHECK(read_seqcount_retry(&sc, seq));
+	write_seqcount_end(&sc);
+
+	/* A completed write is also seen by a reader which started before */
+	CHECK((sc.seq & 1U) == 0U);
+	CHECK(read_seqcount_retry(&sc, seq));
+
+	seq = read_seqcount_begin(&sc);
+	CHECK(!read_seqcount_retry(&sc, seq));
+}
+
+HOST_TEST(seqlock_sequence)
+{
+	seqlock_t sl = { 0 };
+	uint32_t seq;
+
+	seq = read_seqbegin(&sl);
+	write_seqlock(&sl);
+	CHECK(sl.lock.lock != 0U);
+	CHECK(read_seqretry(&sl, seq));
+	write_sequnlock(&sl);
+	CHECK(sl.lock.lock == 0U);
+
+	seq = read_seqbegin(&sl);
+	CHECK(!read_seqretry(&sl, seq));
+}
+
+static void *seq_reader(void *arg)
+{
+	bool use_lock = (arg != NULL);
+	unsigned long a, b;
+	uint32_t seq;
+
+	while (!seq_done) {
+		do {
+			seq = use_lock ? read_seqbegin(&seq_lock) :
+					 read_seqcount_begin(&seq_count);
+			a = seq_data.a;
+			b = seq_data.b;
+		} while (use_lock ? read_seqretry(&seq_lock, seq) :
+				    read_seqcount_retry(&seq_count, seq));
+
+		if (b != ~a) {
+			__atomic_fetch_add(&seq_torn, 1UL, __ATOMIC_RELAXED);
+		}
+	}
+
+	return NULL;
+}
+
+static void *seq_writer(void *arg)
+{
+	bool use_lock = (arg != NULL);
+	unsigned long i;
+
+	for (i = 0UL; i < SEQ_ITERATIONS; i++) {
+		if (use_lock) {
+			write_seqlock(&seq_lock);
+		} else {
+			write_seqcount_begin(&seq_count);
+		}
+
+		seq_data.a = seq_data.a + 1UL;
+		seq_data.b = ~seq_data.a;
+
+		if (use_lock) {
+			write_sequnlock(&seq_lock);
+		} else {
+			write_seqcount_end(&seq_count);
+		}
+	}
+
+	return NULL;
+}
+
+/* Run the readers against the given number of writers */
+static void seq_run(bool use_lock, unsigned int writers)
+{
+	pthread_t readers[SEQ_READERS], writer[SEQ_WRITERS];
+	void *arg = use_lock ? &seq_lock : NULL;
+	unsigned int i;
+
+	seq_data.a = 0UL;
+	seq_data.b = ~0UL;
+	seq_done = false;
+	seq_torn = 0UL;
+
+	for (i = 0U; i < SEQ_READERS; i++) {
+		CHECK(pthread_create(&readers[i], NULL, seq_reader, arg) == 0);
+	}
+	for (i = 0U; i < writers; i++) {
+		CHECK(pthread_create(&writer[i], NULL, seq_writer, arg) == 0);
+	}
+
+	for (i = 0U; i < writers; i++) {
+		pthread_join(writer[i], NULL);
+	}
+	seq_done = true;
+	for (i = 0U; i < SEQ_READERS; i++) {
+		pthread_join(readers[i], NULL);
+	}
+
+	CHECK(seq_torn == 0UL);
+	/* Writers serialised by the lock must not lose any update */
+	CHECK(seq_data.a == (writers * SEQ_ITERATIONS));
+}
+
+HOST_TEST(seqcount_single_writer)
+{
+	seq_count.seq = 0U;
+	seq_run(false, 1U);
+	CHECK(seq_count.seq == (2U * SEQ_ITERATIONS));
+}
+
+HOST_TEST(seqlock_concurrent_writers)
+{
+	seq_lock = (seqlock_t){ 0 };
+	seq_run(true, SEQ_WRITERS);
+	CHECK(seq_lock.sc.seq == (2U * SEQ_WRITERS * SEQ_ITERATIONS));
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <plat/common/plat_trng.h>
+#include <trng_entropy_pool.h>
+
+#include "host_tests.h"
+
+#define TRNG_MAX_BITS		192U
+#define TRNG_MAX_WORDS		(TRNG_MAX_BITS / 64U)
+#define TRNG_ITERATIONS		100000U
+#define TRNG_THREADS		4U
+#define TRNG_THREAD_PACKS	20000U
+
+/*
+ * Simulated entropy source. Word n of the stream is trng_word(n), and the
+ * source runs dry after trng_budget words.
+ */
+static uint64_t trng_next;
+static uint64_t trng_budget;
+static bool trng_counter;
+
+static uint64_t trng_word(uint64_t n)
+{
+	uint64_t z;
+
+	if (trng_counter) {
+		return n + 1U;
+	}
+
+	/* splitmix64 */
+	z = (n + 1U) * 0x9e3779b97f4a7c15ULL;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+	return z ^ (z >> 31);
+}
+
+bool plat_get_entropy(uint64_t *out)
+{
+	if (trng_next == trng_budget) {
+		return false;
+	}
+
+	*out = trng_word(trng_next++);
+
+	return true;
+}
+
+static void trng_reset(bool counter)
+{
+	trng_next = 0U;
+	trng_budget = UINT64_MAX;
+	trng_counter = counter;
+	trng_entropy_pool_setup();
+}
+
+/* Bits [pos, pos + nbits) of the stream, packed like trng_pack_entropy() */
+static void trng_expected(uint64_t pos, uint32_t nbits, uint64_t *out)
+{
+	uint32_t i;
+
+	memset(out, 0, TRNG_MAX_WORDS * sizeof(uint64_t));
+
+	for (i = 0U; i < nbits; i++) {
+		uint64_t bit = pos + i;
+
+		if (((trng_word(bit / 64U) >> (bit % 64U)) & 1U) != 0U) {
+			out[i / 64U] |= 1ULL << (i % 64U);
+		}
+	}
+}
+
+/*
+ * Request random amounts of entropy and check that each request gets the next
+ * bits of the stream, none being lost or handed out twice.
+ */
+HOST_TEST(trng_pack_stream)
+{
+	uint64_t out[TRNG_MAX_WORDS + 1U], expected[TRNG_MAX_WORDS];
+	uint64_t pos = 0U, rng = 1U;
+	uint32_t nbits, words;
+	unsigned int i;
+
+	trng_reset(false);
+
+	for (i = 0U; i < TRNG_ITERATIONS; i++) {
+		rng ^= rng << 13;
+		rng ^= rng >> 7;
+		rng ^= rng << 17;
+		nbits = 1U + (uint32_t)(rng % TRNG_MAX_BITS);
+		words = (nbits + 63U) / 64U;
+
+		/* The word after the request must not be written */
+		memset(out, 0x5a, sizeof(out));
+		CHECK(trng_pack_entropy(nbits, out));
+		trng_expected(pos, nbits, expected);
+
+		if ((memcmp(out, expected, words * sizeof(uint64_t)) != 0) ||
+		    (out[words] != 0x5a5a5a5a5a5a5a5aULL)) {
+			printf("    request %u: %u bits at bit %llu\n", i, nbits,
+			       (unsigned long long)pos);
+			CHECK(memcmp(out, expected,
+				     words * sizeof(uint64_t)) == 0);
+			CHECK(out[words] == 0x5a5a5a5a5a5a5a5aULL);
+			return;
+		}
+		pos += nbits;
+
+		/* The pool only fetches the words it needs */
+		CHECK(trng_next == (pos + 63U) / 64U);
+	}
+}
+
+/* Running out of entropy fails the request and loses nothing */
+HOST_TEST(trng_pack_dry_source)
+{
+	uint64_t out[TRNG_MAX_WORDS], expected[TRNG_MAX_WORDS];
+
+	trng_reset(false);
+	trng_budget = 1U;
+
+	CHECK(trng_pack_entropy(10U, out));
+	trng_expected(0U, 10U, expected);
+	CHECK(out[0] == expected[0]);
+
+	/* 54 bits are left in the pool, and only 54 + 64 can be fetched */
+	CHECK(trng_pack_entropy(54U, out));
+	CHECK(!trng_pack_entropy(TRNG_MAX_BITS, out));
+	trng_budget = 2U;
+	CHECK(!trng_pack_entropy(TRNG_MAX_BITS, out));
+	CHECK(trng_next == 2U);
+
+	/* Once the source is back, the stream carries on where it was */
+	trng_budget = UINT64_MAX;
+	CHECK(trng_pack_entropy(TRNG_MAX_BITS, out));
+	trng_expected(64U, TRNG_MAX_BITS, expected);
+	CHECK(memcmp(out, expected, sizeof(out)) == 0);
+
+	/* Setting the pool up again drops what it holds */
+	CHECK(trng_pack_entropy(1U, out));
+	trng_entropy_pool_setup();
+	CHECK(trng_pack_entropy(64U, out));
+	CHECK(out[0] == trng_word(trng_next - 1U));
+}
+
+static uint64_t trng_thread_out[TRNG_THREADS][TRNG_THREAD_PACKS];
+
+static void *trng_thread(void *arg)
+{
+	uint64_t *out = arg;
+	unsigned int i;
+
+	for (i = 0U; i < TRNG_THREAD_PACKS; i++) {
+		if (!trng_pack_entropy(64U, &out[i])) {
+			out[i] = 0U;
+		}
+	}
+
+	return NULL;
+}
+
+static int trng_cmp(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Several threads request whole words from a source counting from 1, so they
+ * must get every word exactly once between them.
+ */
+HOST_TEST(trng_pack_concurrent)
+{
+	pthread_t threads[TRNG_THREADS];
+	uint64_t *all = &trng_thread_out[0][0];
+	unsigned int i;
+
+	trng_reset(true);
+
+	for (i = 0U; i < TRNG_THREADS; i++) {
+		pthread_create(&threads[i], NULL, trng_thread,
+			       trng_thread_out[i]);
+	}
+	for (i = 0U; i < TRNG_THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	qsort(all, TRNG_THREADS * TRNG_THREAD_PACKS, sizeof(uint64_t),
+	      trng_cmp);
+	for (i = 0U; i < TRNG_THREADS * TRNG_THREAD_PACKS; i++) {
+		if (all[i] != i + 1U) {
+			printf("    word %u is %llu\n", i,
+			       (unsigned long long)all[i]);
+			CHECK(all[i] == i + 1U);
+			return;
+		}
+	}
+}
+
+static void trng_bench_pack(const char *what, uint32_t nbits)
+{
+	uint64_t out[TRNG_MAX_WORDS];
+	unsigned long ops = 2000000UL, i;
+	uint64_t start;
+
+	trng_reset(false);
+
+	start = host_time_ns();
+	for (i = 0UL; i < ops; i++) {
+		(void)trng_pack_entropy(nbits, out);
+	}
+	host_bench_report(what, ops, host_time_ns() - start);
+}
+
+HOST_BENCH(trng_bench)
+{
+	trng_bench_pack("trng_pack_entropy 64 bits", 64U);
+	trng_bench_pack("trng_pack_entropy 192 bits", 192U);
+	trng_bench_pack("trng_pack_entropy 37 bits", 37U);
+}
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <platform_def.h>
+
+#include <arch_sim.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+
+#include "../../../lib/xlat_tables_v2/xlat_tables_private.h"
+#include "host_tests.h"
+
+/*
+ * Tests of the dynamic mapping functions of the translation tables library.
+ * The fuzz test applies random sequences of mmap_add_dynamic_region_ctx() and
+ * mmap_remove_dynamic_region_ctx() calls and, after each of them, compares the
+ * translation tables with a reference model of the mapped regions.
+ */
+
+#define VA_SPACE_SIZE		PLAT_VIRT_ADDR_SPACE_SIZE
+#define PA_SPACE_SIZE		PLAT_PHY_ADDR_SPACE_SIZE
+
+/*
+ * The fuzz test has enough tables for most additions to succeed, but not for
+ * all of them, so that the error paths are also exercised.
+ */
+#define FUZZ_XLAT_TABLES	14
+
+/* Default seed and number of operations of the fuzz test */
+#define FUZZ_DEFAULT_SEED	1ULL
+#define FUZZ_DEFAULT_ITERS	20000UL
+
+/* Result of an addition that depends on the free tables, 0 or -ENOMEM */
+#define ADD_RESULT_UNKNOWN	1
+
+/* Number of iterations of each benchmark */
+#define BENCH_ITERS		20000UL
+
+REGISTER_XLAT_CONTEXT2(fuzz, MAX_MMAP_REGIONS, FUZZ_XLAT_TABLES,
+		       VA_SPACE_SIZE, PA_SPACE_SIZE, EL3_REGIME,
+		       "xlat_table", "base_xlat_table");
+
+REGISTER_XLAT_CONTEXT2(bench, MAX_MMAP_REGIONS, MAX_XLAT_TABLES,
+		       VA_SPACE_SIZE, PA_SPACE_SIZE, EL3_REGIME,
+		       "xlat_table", "base_xlat_table");
+
+/* Regions mapped before the tables are initialized, as a BL image would */
+static const mmap_region_t static_regions[] = {
+	MAP_REGION_FLAT(0x0, 0x200000, MT_CODE | MT_SECURE),
+	MAP_REGION_FLAT(0x200000, 0x3000, MT_RW_DATA | MT_SECURE),
+	MAP_REGION_FLAT(0x80000000, PAGE_SIZE,
+			MT_DEVICE | MT_RW | MT_SECURE | MT_EXECUTE_NEVER),
+	{0}
+};
+
+static const uint32_t region_attrs[] = {
+	MT_RW_DATA | MT_SECURE,
+	MT_RO_DATA | MT_NS,
+	MT_CODE | MT_SECURE,
+	MT_DEVICE | MT_RW | MT_SECURE | MT_EXECUTE_NEVER,
+	MT_NON_CACHEABLE | MT_RW | MT_NS | MT_EXECUTE_NEVER,
+};
+
+/* Reference model: the regions that are expected to be mapped */
+static mmap_region_t model[MAX_MMAP_REGIONS];
+static unsigned int model_num;
+
+static uint64_t rand_state;
+
+/* xorshift64*, so that a seed gives the same sequence on every host */
+static uint64_t rand_next(void)
+{
+	rand_state ^= rand_state >> 12;
+	rand_state ^= rand_state << 25;
+	rand_state ^= rand_state >> 27;
+
+	return rand_state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint64_t rand_below(uint64_t limit)
+{
+	return rand_next() % limit;
+}
+
+static unsigned long long env_or_default(const char *name,
+					 unsigned long long def)
+{
+	const char *str = getenv(name);
+
+	return (str != NULL) ? strtoull(str, NULL, 0) : def;
+}
+
+static bool ranges_overlap(unsigned long long base1, size_t size1,
+			   unsigned long long base2, size_t size2)
+{
+	return (base1 <= (base2 + size2 - 1U)) &&
+	       (base2 <= (base1 + size1 - 1U));
+}
+
+static void model_add(const mmap_region_t *mm)
+{
+	model[model_num++] = *mm;
+}
+
+static void model_remove(unsigned int idx)
+{
+	model[idx] = model[--model_num];
+}
+
+static int model_find(uintptr_t base_va, size_t size)
+{
+	for (unsigned int i = 0U; i < model_num; i++) {
+		if ((model[i].base_va == base_va) && (model[i].size == size)) {
+			return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+/* Returns the result expected when adding a dynamic region */
+static int model_add_result(const mmap_region_t *mm)
+{
+	if (model_num == MAX_MMAP_REGIONS) {
+		return -ENOMEM;
+	}
+
+	/* Dynamic regions must be fully separated from all other regions */
+	for (unsigned int i = 0U; i < model_num; i++) {
+		if (ranges_overlap(mm->base_va, mm->size,
+				   model[i].base_va, model[i].size) ||
+		    ranges_overlap(mm->base_pa, mm->size,
+				   model[i].base_pa, model[i].size)) {
+			return -EPERM;
+		}
+	}
+
+	/* The tables may run out, in which case nothing is mapped */
+	return ADD_RESULT_UNKNOWN;
+}
+
+static int model_remove_result(uintptr_t base_va, size_t size)
+{
+	int idx = model_find(base_va, size);
+
+	if (idx < 0) {
+		return -EINVAL;
+	}
+
+	return ((model[idx].attr & MT_DYNAMIC) != 0U) ? 0 : -EPERM;
+}
+
+static const mmap_region_t *model_lookup(uintptr_t va, size_t size)
+{
+	for (unsigned int i = 0U; i < model_num; i++) {
+		if (ranges_overlap(va, size, model[i].base_va,
+				   model[i].size)) {
+			return &model[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Walks the translation tables and checks every entry against the model. A
+ * block or page descriptor must be fully inside a region and encode the right
+ * output address and attributes, an invalid one mustn't translate any address
+ * of any region. Returns the number of tables below the base level.
+ */
+static unsigned int check_table(const xlat_ctx_t *ctx, const uint64_t *table,
+				unsigned int entries, unsigned int level,
+				uintptr_t base_va)
+{
+	const uint64_t cont = ULL(1) << CONT_HINT_SHIFT;
+	size_t block_size = XLAT_BLOCK_SIZE(level);
+	unsigned int tables = 0U;
+
+	unsigned int valid = 0U;
+
+	for (unsigned int i = 0U; i < entries; i++) {
+		uintptr_t va = base_va + (i * block_size);
+		uint64_t desc = table[i];
+		const mmap_region_t *mm = model_lookup(va, block_size);
+		unsigned long long pa;
+
+		if ((desc & DESC_MASK) == INVALID_DESC) {
+			CHECK(mm == NULL);
+			continue;
+		}
+
+		valid++;
+
+		if ((level < XLAT_TABLE_LEVEL_MAX) &&
+		    ((desc & DESC_MASK) == TABLE_DESC)) {
+			tables += 1U + check_table(ctx,
+				(const uint64_t *)(uintptr_t)
+					(desc & TABLE_ADDR_MASK),
+				XLAT_TABLE_ENTRIES, level + 1U, va);
+			continue;
+		}
+
+		CHECK(mm != NULL);
+		if (mm == NULL) {
+			continue;
+		}
+
+		CHECK((va >= mm->base_va) &&
+		      ((va + block_size - 1U) <= (mm->base_va + mm->size - 1U)));
+
+		pa = mm->base_pa + (va - mm->base_va);
+		CHECK((desc & ~cont) ==
+		      (xlat_desc(ctx, mm->attr, pa, level) & ~cont));
+	}
+
+#if XLAT_TABLES_CONT_HINT
+	/* A Contiguous hint covers a whole aligned run of consecutive blocks */
+	for (unsigned int i = 0U; (i + XLAT_CONT_ENTRIES) <= entries;
+	     i += XLAT_CONT_ENTRIES) {
+		if ((table[i] & cont) == 0U) {
+			continue;
+		}
+
+		for (unsigned int j = 0U; j < XLAT_CONT_ENTRIES; j++) {
+			CHECK(table[i + j] == (table[i] + (j * block_size)));
+		}
+	}
+#endif
+
+	/* Tables that don't map anything must have been released */
+	CHECK((level == ctx->base_level) || (valid != 0U));
+
+	return tables;
+}
+
+static void check_tables(const xlat_ctx_t *ctx)
+{
+	unsigned int tables, used, max_used, total;
+
+	tables = check_table(ctx, ctx->base_table, ctx->base_table_entries,
+			     ctx->base_level, 0U);
+
+	/* All the tables in use, and only them, are linked from the base */
+	xlat_get_tables_usage_ctx(ctx, &used, &max_used, &total);
+	CHECK(tables == used);
+	CHECK(used <= max_used);
+	CHECK(max_used <= total);
+}
+
+static void random_region(mmap_region_t *mm)
+{
+	unsigned int kind = (unsigned int)rand_below(8U);
+	size_t align, size;
+
+	if (kind < 5U) {
+		/* A few pages */
+		align = PAGE_SIZE;
+		size = (1U + rand_below(64U)) * PAGE_SIZE;
+	} else if (kind < 7U) {
+		/* Level 2 blocks, possibly followed by a few pages */
+		align = XLAT_BLOCK_SIZE(2U);
+		size = ((1U + rand_below(4U)) * align) +
+		       (rand_below(16U) * PAGE_SIZE);
+	} else {
+		/* A level 1 block */
+		align = XLAT_BLOCK_SIZE(1U);
+		size = align;
+	}
+
+	mm->base_va = rand_below((VA_SPACE_SIZE - size) / align) * align;
+	mm->base_pa = rand_below((PA_SPACE_SIZE - size) / align) * align;
+	mm->size = size;
+	mm->attr = region_attrs[rand_below(ARRAY_SIZE(region_attrs))];
+	mm->granularity = REGION_DEFAULT_GRANULARITY;
+}
+
+static void setup_ctx(xlat_ctx_t *ctx, bool with_model)
+{
+	arch_sim_reset();
+	model_num = 0U;
+
+	for (const mmap_region_t *mm = static_regions; mm->size != 0U; mm++) {
+		mmap_add_region_ctx(ctx, mm);
+		if (with_model) {
+			model_add(mm);
+		}
+	}
+
+	init_xlat_tables_ctx(ctx);
+
+	/* Regions added from now on are dynamic and can be removed */
+	arch_sim_mmu_enabled = true;
+}
+
+HOST_TEST(xlat_dynamic_regions_fuzz)
+{
+	xlat_ctx_t *ctx = &fuzz_xlat_ctx;
+	unsigned long long seed = env_or_default("HOST_XLAT_FUZZ_SEED",
+						 FUZZ_DEFAULT_SEED);
+	unsigned long iters = env_or_default("HOST_XLAT_FUZZ_ITERS",
+					     FUZZ_DEFAULT_ITERS);
+	unsigned long added = 0UL, removed = 0UL, nomem = 0UL, denied = 0UL;
+	unsigned int base_used, used, max_used, total;
+	unsigned int failures = host_test_failures();
+	mmap_region_t mm;
+	int expected, ret;
+
+	printf("    seed %llu, %lu operations\n", seed, iters);
+	rand_state = (seed != 0ULL) ? seed : FUZZ_DEFAULT_SEED;
+
+	setup_ctx(ctx, true);
+	check_tables(ctx);
+	xlat_get_tables_usage_ctx(ctx, &base_used, &max_used, &total);
+
+	for (unsigned long n = 0UL; n < iters; n++) {
+		unsigned long tlbi = arch_sim_tlbi_count();
+
+		/* Keep the mmap array about half full */
+		if (rand_below(MAX_MMAP_REGIONS) >= model_num) {
+			random_region(&mm);
+			expected = model_add_result(&mm);
+
+			ret = mmap_add_dynamic_region_ctx(ctx, &mm);
+
+			if (expected == ADD_RESULT_UNKNOWN) {
+				CHECK((ret == 0) || (ret == -ENOMEM));
+				expected = ret;
+			} else {
+				CHECK(ret == expected);
+			}
+
+			if (ret == 0) {
+				model_add(&mm);
+				added++;
+				/* Only invalid descriptors have been replaced */
+				CHECK(arch_sim_tlbi_count() == tlbi);
+			} else if (ret == -ENOMEM) {
+				nomem++;
+			} else {
+				denied++;
+			}
+		} else {
+			unsigned int kind = (unsigned int)rand_below(8U);
+			uintptr_t base_va;
+			size_t size;
+
+			if (kind < 6U) {
+				/* An existing region, static or dynamic */
+				const mmap_region_t *r =
+					&model[rand_below(model_num)];
+
+				base_va = r->base_va;
+				size = r->size;
+			} else {
+				/* Most likely a region that doesn't exist */
+				random_region(&mm);
+				base_va = mm.base_va;
+				size = mm.size;
+			}
+
+			expected = model_remove_result(base_va, size);
+
+			ret = mmap_remove_dynamic_region_ctx(ctx, base_va,
+							     size);
+			CHECK(ret == expected);
+
+			if (ret == 0) {
+				model_remove((unsigned int)
+					     model_find(base_va, size));
+				removed++;
+				/* The old descriptors may be in the TLBs */
+				CHECK(arch_sim_tlbi_count() > tlbi);
+			} else {
+				denied++;
+			}
+		}
+
+		check_tables(ctx);
+
+		/* Stop at the first divergence, the state is unknown after it */
+		if (host_test_failures() != failures) {
+			printf("    operation %lu failed, stopping\n", n);
+			break;
+		}
+	}
+
+	printf("    %lu added, %lu removed, %lu out of memory, %lu denied\n",
+	       added, removed, nomem, denied);
+
+	/* Releasing all the dynamic regions gives all their tables back */
+	for (unsigned int i = 0U; i < model_num;) {
+		if ((model[i].attr & MT_DYNAMIC) == 0U) {
+			i++;
+			continue;
+		}
+
+		CHECK(mmap_remove_dynamic_region_ctx(ctx, model[i].base_va,
+						     model[i].size) == 0);
+		model_remove(i);
+	}
+
+	check_tables(ctx);
+	xlat_get_tables_usage_ctx(ctx, &used, &max_used, &total);
+	CHECK(used == base_used);
+}
+
+/*
+ * Maps and unmaps the same region repeatedly, which is what the drivers that
+ * map buffers on demand do, and reports the cost of both operations.
+ */
+static void bench_map_unmap(xlat_ctx_t *ctx, const char *what, size_t size)
+{
+	mmap_region_t mm;
+	uint64_t start, map_ns = 0U, unmap_ns = 0U;
+	unsigned long tlbi, syncs, dc_lines;
+	unsigned int used, max_used, total;
+	char label[64];
+
+	tlbi = arch_sim_tlbi_count();
+	syncs = arch_sim_stats.tlbi_sync;
+	dc_lines = arch_sim_stats.dc_lines;
+
+	for (unsigned long n = 0UL; n < BENCH_ITERS; n++) {
+		mm = (mmap_region_t)MAP_REGION(0x40000000, 0x40000000, size,
+					       MT_RW_DATA | MT_NS);
+
+		start = host_time_ns();
+		if (mmap_add_dynamic_region_ctx(ctx, &mm) != 0) {
+			CHECK(false);
+			return;
+		}
+		map_ns += host_time_ns() - start;
+
+		start = host_time_ns();
+		if (mmap_remove_dynamic_region_ctx(ctx, mm.base_va,
+						   mm.size) != 0) {
+			CHECK(false);
+			return;
+		}
+		unmap_ns += host_time_ns() - start;
+	}
+
+	xlat_get_tables_usage_ctx(ctx, &used, &max_used, &total);
+
+	(void)snprintf(label, sizeof(label), "map %s", what);
+	host_bench_report(label, BENCH_ITERS, map_ns);
+	(void)snprintf(label, sizeof(label), "unmap %s", what);
+	host_bench_report(label, BENCH_ITERS, unmap_ns);
+	printf("    %-40s per map + unmap: %.1f TLBI, %.1f sync, %.1f DC lines\n",
+	       "",
+	       (double)(arch_sim_tlbi_count() - tlbi) / BENCH_ITERS,
+	       (double)(arch_sim_stats.tlbi_sync - syncs) / BENCH_ITERS,
+	       (double)(arch_sim_stats.dc_lines - dc_lines) / BENCH_ITERS);
+	printf("    %-40s tables: %u used, %u max used, %u total\n", "",
+	       used, max_used, total);
+}
+
+HOST_BENCH(xlat_dynamic_regions_bench)
+{
+	xlat_ctx_t *ctx = &bench_xlat_ctx;
+
+	setup_ctx(ctx, false);
+
+	bench_map_unmap(ctx, "1 page", PAGE_SIZE);
+	bench_map_unmap(ctx, "16 pages", 16U * PAGE_SIZE);
+	bench_map_unmap(ctx, "17 pages", 17U * PAGE_SIZE);
+	bench_map_unmap(ctx, "1 level 2 block", XLAT_BLOCK_SIZE(2U));
+	bench_map_unmap(ctx, "1 level 2 block + 1 page",
+			XLAT_BLOCK_SIZE(2U) + PAGE_SIZE);
+	bench_map_unmap(ctx, "1 level 1 block", XLAT_BLOCK_SIZE(1U));
+}
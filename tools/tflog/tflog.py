@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Decode the log records saved by BL31 when built with LOG_BINARY=1. The input
+# is a raw image of the 'tf_log_bin_buf' variable of BL31, for example read
+# back with a debugger, and the BL31 ELF file the records were made by, which
+# holds the format strings in its .tf_log_fmt section. The layout of the
+# records is described in include/common/tf_log_bin.h.
+#
+# Usage: tflog.py <dump.bin> <bl31.elf>
+
+import re
+import struct
+import sys
+
+TF_LOG_BIN_MAGIC = 0x474c4654
+TF_LOG_BIN_VERSION = 1
+TF_LOG_BIN_REC_HDR_WORDS = 2
+
+prefixes = {10: 'ERROR:   ', 20: 'NOTICE:  ', 30: 'WARNING: ',
+            40: 'INFO:    ', 50: 'VERBOSE: '}
+
+conv_re = re.compile(r'%(0?)([0-9]*)(ll|l|z)?([diuxpsc%])')
+
+
+class Elf:
+    """Minimal reader for the little-endian ELF64 files of BL31."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4] != 2:
+            sys.exit('%s is not an ELF64 file' % path)
+
+        (phoff, shoff) = struct.unpack_from('<QQ', self.data, 0x20)
+        (phentsize, phnum, shentsize, shnum, shstrndx) = \
+            struct.unpack_from('<HHHHH', self.data, 0x36)
+
+        self.segments = []
+        for i in range(phnum):
+            (p_type, _, p_offset, p_vaddr, _, p_filesz) = \
+                struct.unpack_from('<IIQQQQ', self.data, phoff + i * phentsize)
+            if p_type == 1:     # PT_LOAD
+                self.segments.append((p_vaddr, p_offset, p_filesz))
+
+        sections = []
+        for i in range(shnum):
+            (name, _, _, _, offset, size) = \
+                struct.unpack_from('<IIQQQQ', self.data, shoff + i * shentsize)
+            sections.append((name, offset, size))
+        strtab = sections[shstrndx][1]
+        self.sections = {}
+        for (name, offset, size) in sections:
+            end = self.data.index(b'\0', strtab + name)
+            self.sections[self.data[strtab + name:end].decode()] = \
+                self.data[offset:offset + size]
+
+    def string_at(self, addr):
+        for (vaddr, offset, size) in self.segments:
+            if vaddr <= addr < vaddr + size:
+                start = offset + addr - vaddr
+                end = self.data.find(b'\0', start, offset + size)
+                if end >= 0:
+                    return self.data[start:end].decode(errors='replace')
+        return None
+
+
+def c_string(data, offset):
+    end = data.index(b'\0', offset)
+    return data[offset:end].decode(errors='replace')
+
+
+def format_msg(fmt, args, elf):
+    args = list(args)
+
+    def conv(m):
+        (zero, width, length, spec) = m.groups()
+        if spec == '%':
+            return '%'
+        value = args.pop(0) if args else 0
+        # Pointers are 64-bit whatever the length modifier
+        if length is None and spec in 'diuxc':
+            value &= 0xffffffff
+        bits = 64 if length else 32
+        if spec in 'di' and value >= 1 << (bits - 1):
+            value -= 1 << bits
+        if spec in 'diu':
+            text = '%d' % value
+        elif spec == 'x':
+            text = '%x' % value
+        elif spec == 'p':
+            text = '0x%x' % value
+        elif spec == 'c':
+            text = chr(value & 0xff)
+        else:
+            text = elf.string_at(value)
+            if text is None:
+                text = '<string at 0x%x>' % value
+        pad = '0' if zero and spec != 's' else ' '
+        return text.rjust(int(width or 0), pad)
+
+    return conv_re.sub(conv, fmt)
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit('usage: %s <dump.bin> <bl31.elf>' % sys.argv[0])
+
+    with open(sys.argv[1], 'rb') as f:
+        data = f.read()
+    elf = Elf(sys.argv[2])
+    fmts = elf.sections.get('.tf_log_fmt')
+    if fmts is None:
+        sys.exit('%s was not built with LOG_BINARY=1' % sys.argv[2])
+
+    (magic, version, num_cpus, ring_words, cpus_offset, ring_size) = \
+        struct.unpack_from('<IIIIII', data, 0)
+    if magic != TF_LOG_BIN_MAGIC:
+        sys.exit('No log records found (magic 0x%x)' % magic)
+    if version != TF_LOG_BIN_VERSION:
+        sys.exit('Unsupported log records version %d' % version)
+
+    records = []
+    for cpu in range(num_cpus):
+        base = cpus_offset + cpu * ring_size
+        (head, tail) = struct.unpack_from('<QQ', data, base)
+        words = struct.unpack_from('<%dQ' % ring_words, data, base + 16)
+        pos = tail
+        while pos < head:
+            hdr = words[pos % ring_words]
+            nargs = hdr & 0xff
+            if pos + TF_LOG_BIN_REC_HDR_WORDS + nargs > head:
+                break
+            cntpct = words[(pos + 1) % ring_words]
+            args = [words[(pos + TF_LOG_BIN_REC_HDR_WORDS + i) % ring_words]
+                    for i in range(nargs)]
+            records.append((cntpct, cpu, hdr >> 32, args))
+            pos += TF_LOG_BIN_REC_HDR_WORDS + nargs
+
+    for (cntpct, cpu, fmt_id, args) in sorted(records):
+        fmt = c_string(fmts, fmt_id)
+        prefix = prefixes.get(ord(fmt[0]), '')
+        msg = format_msg(fmt[1:], args, elf)
+        sys.stdout.write('[cpu%d %016x] %s%s' % (cpu, cntpct, prefix, msg))
+        if not msg.endswith('\n'):
+            sys.stdout.write('\n')
+
+
+if __name__ == '__main__':
+    main()